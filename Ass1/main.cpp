@@ -3,9 +3,23 @@
 #include "../Headers/ImGuiLayer.h"
 #include "../Headers/Animation.h"
 #include "../Headers/Camera.h"
+#include "../Headers/SimulationThread.h"
+#include "../Headers/SceneFile.h"
+#include "../Headers/HeadlessContext.h"
+#include "../Headers/OfflineRenderer.h"
+#include "../Headers/VirtualCameraChannel.h"
+#include "../Headers/Profiler.h"
+#include "../Headers/Trace.h"
+#include "../Headers/Benchmarks.h"
+#include "../Headers/SceneBenchmark.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 // Get the singleton instance of Camera and set its initial position and orientation
 Camera& camera = Camera::getInstance(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, 0.0f);
@@ -19,10 +33,26 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
+std::string tracePath = "trace.json"; // --trace <path>: capture from startup and dump there on exit
+
 void processInput(GLFWwindow* window, float deltaTime) {
     camera.ProcessKeyboard(window, deltaTime);
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true); // Close the window
+
+    // F9 starts a trace capture, or dumps the one in progress
+    static bool f9WasDown = false;
+    bool f9Down = glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS;
+    if (f9Down && !f9WasDown) {
+        if (Trace::isCapturing()) {
+            Trace::dump(tracePath);
+        }
+        else {
+            Trace::setCapturing(true);
+            std::cout << "Trace capture started, press F9 again to write " << tracePath << std::endl;
+        }
+    }
+    f9WasDown = f9Down;
 }
 
 
@@ -164,7 +194,153 @@ void renderCube(const glm::mat4& view, const glm::mat4& projection) {
 }
 
 
-int main() {
+// Headless batch export: steps the animation at a fixed timestep and writes every frame to disk.
+//   --batch <scene> [--out <pattern>] [--frames <n>] [--fps <rate>] [--size <w>x<h>] [--format png|ppm|raw]
+int runBatch(int argc, char** argv) {
+    std::string scenePath;
+    OfflineRenderSettings settings;
+    int frameCount = -1; // Default: long enough for the longest channel
+    float fps = 24.0f;
+    bool outputGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--batch" && hasValue) scenePath = argv[++i];
+        else if (arg == "--out" && hasValue) { settings.outputPattern = argv[++i]; outputGiven = true; }
+        else if (arg == "--frames" && hasValue) frameCount = std::atoi(argv[++i]);
+        else if (arg == "--fps" && hasValue) fps = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--size" && hasValue) std::sscanf(argv[++i], "%dx%d", &settings.width, &settings.height);
+        else if (arg == "--format" && hasValue) {
+            std::string format = argv[++i];
+            if (format == "ppm") settings.format = ImageFormat::PPM;
+            else if (format == "raw") settings.format = ImageFormat::RAW;
+            else settings.format = ImageFormat::PNG;
+        }
+    }
+    if (!outputGiven) {
+        settings.outputPattern = settings.format == ImageFormat::PPM ? "frame_%05d.ppm"
+            : settings.format == ImageFormat::RAW ? "frame_%05d.raw" : "frame_%05d.png";
+    }
+    if (fps <= 0.0f || settings.width <= 0 || settings.height <= 0) {
+        std::cerr << "Invalid --fps or --size" << std::endl;
+        return -1;
+    }
+    if (!OfflineRenderer::isValidPattern(settings.outputPattern)) {
+        std::cerr << "Invalid --out pattern, it needs exactly one %d or %0Nd for the frame number: "
+            << settings.outputPattern << std::endl;
+        return -1;
+    }
+
+    HeadlessContext context;
+    try {
+        context.create();
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    int exitCode = 0;
+    {
+        // Scoped so every GL object is released while the context still exists
+        Animation animation("Main Animation");
+        if (!loadScene(animation, scenePath)) {
+            return -1;
+        }
+
+        for (const auto& channel : animation.getChannels()) {
+            if (channel->getType() == VIRTUAL_CAMERA) {
+                std::static_pointer_cast<VirtualCameraChannel>(channel)->startTraversal();
+            }
+        }
+        if (frameCount < 0) {
+            frameCount = static_cast<int>(animation.getDuration() * fps) + 1;
+        }
+
+        setupCube();
+
+        OfflineRenderer renderer(settings);
+        if (!renderer.init()) {
+            return -1;
+        }
+
+        float step = 1.0f / fps;
+        float aspect = static_cast<float>(settings.width) / settings.height;
+        FrameSnapshot snapshot;
+        auto start = std::chrono::steady_clock::now();
+
+        // Same fixed-step clock as the interactive loop, so both produce identical motion. The
+        // interpolated snapshot trails the clock by one fixed step, so the clock starts that far
+        // ahead: frame k then shows exactly k / fps, starting at 0 and ending within the duration
+        animation.advanceExact(animation.getFixedStep());
+
+        for (int frame = 0; frame < frameCount; ++frame) {
+            TRACE_SCOPE("Frame");
+            animation.captureInterpolated(snapshot);
+            animation.applyCamera(snapshot);
+
+            glm::mat4 view = camera.GetViewMatrix();
+            glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), aspect, 0.1f, 100.0f);
+            animation.setSkyboxView(glm::mat4(glm::mat3(view)));
+
+            renderer.beginFrame();
+            animation.renderSnapshot(snapshot, view, projection);
+            renderCube(view, projection);
+            renderer.endFrame();
+
+            // Never clamped, so the output covers the scene's full duration at any frame rate
+            animation.advanceExact(step);
+        }
+        renderer.finish();
+
+        float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Wrote " << renderer.getFramesWritten() << " frames in " << seconds << " s ("
+            << (seconds > 0.0f ? renderer.getFramesWritten() / seconds : 0.0f) << " fps)" << std::endl;
+        if (renderer.getFramesFailed() > 0) {
+            std::cerr << renderer.getFramesFailed() << " frames failed" << std::endl;
+            exitCode = -1;
+        }
+
+        glDeleteVertexArrays(1, &cubeVAO);
+        glDeleteBuffers(1, &cubeVBO);
+        glDeleteProgram(cubeShaderProgram);
+    }
+    return exitCode;
+}
+
+int main(int argc, char** argv) {
+    // --sim-thread: update the animation on its own thread and render its latest snapshot
+    // --trace <path>: capture trace zones from startup, written on exit (also applies to --batch)
+    // --bench: run the CPU kernel micro-benchmarks (see Benchmarks.h) and exit
+    // --scene-bench: render generated scenes offscreen and report frame statistics (see SceneBenchmark.h)
+    bool useSimulationThread = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sim-thread") == 0) {
+            useSimulationThread = true;
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+            Trace::setCapturing(true);
+        }
+    }
+    TRACE_THREAD_NAME("Main");
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0) {
+            return runBenchmarks(argc, argv); // CPU kernels only, no window
+        }
+        if (std::strcmp(argv[i], "--scene-bench") == 0) {
+            return runSceneBenchmark(argc, argv);
+        }
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            int exitCode = runBatch(argc, argv);
+            if (Trace::isCapturing()) {
+                Trace::dump(tracePath);
+            }
+            return exitCode;
+        }
+    }
+
     WindowManager& wm = WindowManager::getInstance();
     try {
         wm.createWindow(1600, 1200, "OpenGL + ImGui");
@@ -182,20 +358,41 @@ int main() {
 
     setupCube();
 
+    SimulationThread simulation(animation);
+    FrameSnapshot localSnapshot;
+    if (useSimulationThread) {
+        setSceneMutex(&simulation.getSceneMutex());
+        simulation.start();
+    }
+
     float lastFrame = 0.0f;
 
     while (!glfwWindowShouldClose(wm.getWindow())) {
+        TRACE_SCOPE("Frame");
         float currentFrame = glfwGetTime();
         float deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        Profiler::getInstance().beginFrame();
+
         processInput(wm.getWindow(), deltaTime);
 
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Update the animation
-        animation.update(deltaTime);
+        // Update the animation, or pick up the newest state from the simulation thread
+        const FrameSnapshot* snapshot = &localSnapshot;
+        if (useSimulationThread) {
+            snapshot = &simulation.latestSnapshot();
+            simulation.releaseRetiredChannels();
+        }
+        else {
+            std::vector<std::shared_ptr<Channel>> replaced; // Released here, on the GL thread
+            animation.applyPublished(replaced);
+            animation.advance(deltaTime);
+            animation.captureInterpolated(localSnapshot);
+        }
+        animation.applyCamera(*snapshot);
 
         // For the skybox, use only the rotational part of the view matrix
         glm::mat4 skyboxView = glm::mat4(glm::mat3(camera.GetViewMatrix())); // Remove translation part
@@ -206,17 +403,25 @@ int main() {
         animation.setSkyboxView(skyboxView);
 
         // Render the skybox
-        animation.render(view, projection);
+        animation.renderSnapshot(*snapshot, view, projection);
 
         // Render the cube
         renderCube(view, projection);
 
         renderImGui();
 
+        Profiler::getInstance().endFrame();
+
         glfwSwapBuffers(wm.getWindow());
         glfwPollEvents();
     }
 
+    simulation.stop();
+    setSceneMutex(nullptr);
+    if (Trace::isCapturing()) {
+        Trace::dump(tracePath);
+    }
+    localSnapshot = FrameSnapshot();
 
     cleanupImGui();
 
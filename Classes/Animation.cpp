@@ -1,38 +1,468 @@
 #include "../Headers/Animation.h"
+#include "../Headers/JobSystem.h"
+#include "../Headers/Camera.h"
+#include "../Headers/Profiler.h"
+#include "../Headers/Trace.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    // Blend two captured states of the same channel; deformation is not blended, the newer one is drawn
+    ChannelState interpolateState(const ChannelState& from, const ChannelState& to, float alpha) {
+        ChannelState state = to;
+        if (from.hasTransform && to.hasTransform) {
+            state.position = glm::mix(from.position, to.position, alpha);
+            state.rotation = glm::slerp(from.rotation, to.rotation, alpha);
+            state.scale = glm::mix(from.scale, to.scale, alpha);
+        }
+        if (from.hasCamera && to.hasCamera) {
+            state.cameraPosition = glm::mix(from.cameraPosition, to.cameraPosition, alpha);
+            glm::vec3 front = glm::mix(from.cameraFront, to.cameraFront, alpha);
+            if (glm::length(front) > 1e-6f) {
+                state.cameraFront = glm::normalize(front);
+            }
+        }
+        return state;
+    }
+}
 
 Animation::Animation(const std::string& name) : name(name) {}
 
+namespace {
+    std::atomic<uint64_t> nextSceneVersion{ 1 };
+}
+
 void Animation::addChannel(std::shared_ptr<Channel> channel) {
+    if (!channel || channelIndices.count(channel->getHandle())) return;
+    channelIndices[channel->getHandle()] = channels.size();
+    indexName(channel->getName(), channel->getHandle());
     channels.push_back(channel);
+    uncommittedChannels.insert(channel->getHandle());
+    resolveReferences();
+    seekPending = true; // Bring the new channel to the playhead
+}
+
+bool Animation::removeChannel(ChannelHandle handle) {
+    auto it = channelIndices.find(handle);
+    if (it == channelIndices.end()) return false;
+    eraseChannel(it->second);
+    uncommittedChannels.erase(handle);
+    removedSinceCommit.push_back(handle);
+
+    // Nothing may keep waiting on, or pointing at, a channel that is gone
+    for (size_t i = 0; i < channels.size(); ++i) {
+        if (channels[i]->dependsOn(handle) || channels[i]->refersTo(handle)) {
+            editChannel(channels[i]->getHandle())->removeDependency(handle);
+        }
+    }
+    resolveReferences();
+    return true;
 }
 
 void Animation::removeChannel(const std::string& channelName) {
-    channels.erase(std::remove_if(channels.begin(), channels.end(),
-        [&channelName](const std::shared_ptr<Channel>& channel) {
-            return channel->getName() == channelName;
-        }), channels.end());
+    auto it = channelsByName.find(channelName);
+    if (it == channelsByName.end()) return;
+    std::vector<ChannelHandle> handles = it->second; // removeChannel edits the index
+    for (ChannelHandle handle : handles) {
+        removeChannel(handle);
+    }
+}
+
+std::shared_ptr<Channel> Animation::getChannel(ChannelHandle handle) const {
+    auto it = channelIndices.find(handle);
+    return (it != channelIndices.end()) ? channels[it->second] : nullptr;
 }
 
 std::shared_ptr<Channel> Animation::getChannel(const std::string& channelName) const {
-    auto it = std::find_if(channels.begin(), channels.end(),
-        [&channelName](const std::shared_ptr<Channel>& channel) {
-            return channel->getName() == channelName;
-        });
-    return (it != channels.end()) ? *it : nullptr;
+    auto it = channelsByName.find(channelName);
+    return (it != channelsByName.end()) ? getChannel(it->second.front()) : nullptr;
+}
+
+size_t Animation::getChannelIndex(ChannelHandle handle) const {
+    auto it = channelIndices.find(handle);
+    return (it != channelIndices.end()) ? it->second : channels.size();
+}
+
+bool Animation::renameChannel(ChannelHandle handle, const std::string& newName) {
+    auto channel = getChannel(handle);
+    if (!channel) return false;
+    if (channel->getName() == newName) return true;
+    unindexName(channel->getName(), handle);
+    editChannel(handle)->setName(newName);
+    indexName(newName, handle);
+    return true;
 }
 
 void Animation::updateChannelName(const std::string& oldName, const std::string& newName) {
     auto channel = getChannel(oldName);
     if (channel) {
-        channel->setName(newName);
+        renameChannel(channel->getHandle(), newName);
+    }
+}
+
+void Animation::indexName(const std::string& channelName, ChannelHandle handle) {
+    std::vector<ChannelHandle>& handles = channelsByName[channelName];
+    // Keep the handles sorted (= creation order), so a name resolves the same way whatever the rename history
+    handles.insert(std::upper_bound(handles.begin(), handles.end(), handle), handle);
+}
+
+void Animation::unindexName(const std::string& channelName, ChannelHandle handle) {
+    auto it = channelsByName.find(channelName);
+    if (it == channelsByName.end()) return;
+    it->second.erase(std::remove(it->second.begin(), it->second.end(), handle), it->second.end());
+    if (it->second.empty()) {
+        channelsByName.erase(it);
+    }
+}
+
+void Animation::eraseChannel(size_t index) {
+    ChannelHandle handle = channels[index]->getHandle();
+    unindexName(channels[index]->getName(), handle);
+    channelIndices.erase(handle);
+    channels.erase(channels.begin() + index);
+    for (size_t i = index; i < channels.size(); ++i) {
+        channelIndices[channels[i]->getHandle()] = i; // Keep the list order, shift the rest down
+    }
+}
+
+void Animation::rebuildIndices() {
+    channelIndices.clear();
+    channelsByName.clear();
+    for (size_t i = 0; i < channels.size(); ++i) {
+        channelIndices[channels[i]->getHandle()] = i;
+        indexName(channels[i]->getName(), channels[i]->getHandle());
+    }
+}
+
+// Committed channels may be playing and are never touched; editChannel() copies and resolves
+// those that refer to a replaced channel, removeChannel() those that refer to a removed one
+void Animation::resolveReferences() const {
+    for (const auto& channel : channels) {
+        if (uncommittedChannels.count(channel->getHandle())) {
+            channel->resolveReferences(*this);
+        }
+    }
+}
+
+bool Animation::addDependency(ChannelHandle channel, ChannelHandle dependency) {
+    auto dependent = getChannel(channel);
+    auto target = getChannel(dependency);
+    if (!dependent || !target || channel == dependency) return false;
+
+    // Refuse dependencies that would close a cycle (the target already waits on the channel)
+    std::vector<ChannelHandle> stack = { dependency };
+    std::unordered_set<ChannelHandle> visited;
+    while (!stack.empty()) {
+        ChannelHandle current = stack.back();
+        stack.pop_back();
+        if (current == channel) {
+            std::cerr << "Cannot make " << dependent->getName() << " depend on " << target->getName() << ": dependency cycle" << std::endl;
+            return false;
+        }
+        if (!visited.insert(current).second) continue;
+        if (auto next = getChannel(current)) {
+            stack.insert(stack.end(), next->getDependencies().begin(), next->getDependencies().end());
+        }
+    }
+
+    editChannel(channel)->addDependency(dependency);
+    return true;
+}
+
+void Animation::removeDependency(ChannelHandle channel, ChannelHandle dependency) {
+    auto dependent = getChannel(channel);
+    if (dependent && dependent->dependsOn(dependency)) {
+        editChannel(channel)->removeDependency(dependency);
+    }
+}
+
+std::shared_ptr<Channel> Animation::editChannel(ChannelHandle handle) {
+    auto it = channelIndices.find(handle);
+    if (it == channelIndices.end()) return nullptr;
+
+    std::shared_ptr<Channel> channel = channels[it->second];
+    if (uncommittedChannels.insert(handle).second) {
+        channel = channel->clone(); // The committed one may be playing, it is never touched again
+        channels[it->second] = channel;
+        channel->resolveReferences(*this);
+
+        // Committed channels pointing at the old object get copies pointing at the new one,
+        // so the commit arrives resolved and the player never mutates what it is playing
+        for (size_t i = 0; i < channels.size(); ++i) {
+            if (channels[i]->refersTo(handle) && !uncommittedChannels.count(channels[i]->getHandle())) {
+                editChannel(channels[i]->getHandle());
+            }
+        }
+    }
+    return channel;
+}
+
+std::shared_ptr<SceneCommit> Animation::commit(bool replaceAll) {
+    auto result = std::make_shared<SceneCommit>();
+    result->version = nextSceneVersion++;
+    result->channels.reserve(uncommittedChannels.size());
+    for (ChannelHandle handle : uncommittedChannels) {
+        result->channels.push_back(getChannel(handle));
+    }
+    // In list order, so channels added since the last commit are appended in the same order
+    std::sort(result->channels.begin(), result->channels.end(),
+        [this](const std::shared_ptr<Channel>& a, const std::shared_ptr<Channel>& b) {
+            return getChannelIndex(a->getHandle()) < getChannelIndex(b->getHandle());
+        });
+    result->removed.swap(removedSinceCommit);
+    if (replaceAll || orderChangedSinceCommit) {
+        result->order.reserve(channels.size());
+        for (const auto& channel : channels) {
+            result->order.push_back(channel->getHandle());
+        }
+    }
+
+    uncommittedChannels.clear();
+    orderChangedSinceCommit = false;
+    return result;
+}
+
+void Animation::publish(std::shared_ptr<SceneCommit> commit) {
+    if (!commit) return;
+    // Chain onto a commit the player has not taken yet; it applies both, oldest first
+    std::shared_ptr<SceneCommit> pending = std::atomic_load(&publishedCommit);
+    do {
+        commit->previous = pending;
+    } while (!std::atomic_compare_exchange_weak(&publishedCommit, &pending, commit));
+}
+
+bool Animation::applyPublished(std::vector<std::shared_ptr<Channel>>& released) {
+    std::shared_ptr<SceneCommit> newest = std::atomic_exchange(&publishedCommit, std::shared_ptr<SceneCommit>());
+    if (!newest) return false;
+
+    std::vector<const SceneCommit*> pending;
+    for (const SceneCommit* commit = newest.get(); commit && commit->version > appliedVersion; commit = commit->previous.get()) {
+        pending.push_back(commit);
+    }
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        applyCommit(**it, released);
+    }
+    return !pending.empty();
+}
+
+void Animation::applyCommit(const SceneCommit& commit, std::vector<std::shared_ptr<Channel>>& released) {
+    if (!commit.order.empty()) {
+        // The order changed: rebuild the list from the committed channels and the ones kept
+        std::unordered_map<ChannelHandle, std::shared_ptr<Channel>> committed;
+        for (const auto& channel : commit.channels) {
+            committed[channel->getHandle()] = channel;
+        }
+        std::vector<std::shared_ptr<Channel>> next;
+        next.reserve(commit.order.size());
+        for (ChannelHandle handle : commit.order) {
+            auto it = committed.find(handle);
+            auto channel = (it != committed.end()) ? it->second : getChannel(handle);
+            if (channel) next.push_back(channel);
+        }
+        released.insert(released.end(), channels.begin(), channels.end());
+        channels.swap(next);
+        rebuildIndices();
     }
+    else {
+        for (ChannelHandle handle : commit.removed) {
+            auto it = channelIndices.find(handle);
+            if (it == channelIndices.end()) continue; // Added and removed again before the commit
+            released.push_back(channels[it->second]);
+            eraseChannel(it->second);
+        }
+        for (const auto& channel : commit.channels) {
+            auto it = channelIndices.find(channel->getHandle());
+            if (it == channelIndices.end()) {
+                channelIndices[channel->getHandle()] = channels.size();
+                indexName(channel->getName(), channel->getHandle());
+                channels.push_back(channel);
+                continue;
+            }
+            std::shared_ptr<Channel>& current = channels[it->second];
+            if (current->getName() != channel->getName()) {
+                unindexName(current->getName(), channel->getHandle());
+                indexName(channel->getName(), channel->getHandle());
+            }
+            released.push_back(current);
+            current = channel;
+        }
+    }
+
+    // No resolving here: the commit's channels were resolved by the editing animation,
+    // and the channels it keeps may be read by the render thread
+    appliedVersion = commit.version;
+    seekPending = true; // New channels start at the playhead like added ones
+}
+
+// Build the dependency graph between channels of this animation and a topological update order.
+// Returns false if there is a cycle; the channels caught in it are appended in list order.
+bool Animation::buildUpdateOrder(std::vector<size_t>& order, std::vector<std::vector<size_t>>& dependents, std::vector<int>& dependencyCount) const {
+    dependents.assign(channels.size(), {});
+    dependencyCount.assign(channels.size(), 0);
+    for (size_t i = 0; i < channels.size(); ++i) {
+        for (const auto& dependency : channels[i]->getDependencies()) {
+            auto it = channelIndices.find(dependency);
+            if (it == channelIndices.end()) continue; // Dependency is not part of this animation
+            dependents[it->second].push_back(i);
+            ++dependencyCount[i];
+        }
+    }
+
+    order.clear();
+    std::vector<int> remaining = dependencyCount;
+    for (size_t i = 0; i < channels.size(); ++i) {
+        if (remaining[i] == 0) order.push_back(i);
+    }
+    for (size_t next = 0; next < order.size(); ++next) {
+        for (size_t dependent : dependents[order[next]]) {
+            if (--remaining[dependent] == 0) order.push_back(dependent);
+        }
+    }
+
+    if (order.size() != channels.size()) {
+        std::cerr << "Channel dependency cycle detected, updating the affected channels in list order." << std::endl;
+        for (size_t i = 0; i < channels.size(); ++i) {
+            if (remaining[i] > 0) order.push_back(i);
+        }
+        return false;
+    }
+    return true;
+}
+
+void Animation::seek(float time) {
+    playhead = std::max(time, 0.0f);
+    seekPending = true;
+}
+
+float Animation::getDuration() const {
+    float duration = 0.0f;
+    for (const auto& channel : channels) {
+        duration = std::max(duration, channel->getEndTime());
+    }
+    return duration;
+}
+
+// Moves the playhead according to the playback mode; true if it jumped (loop wrap)
+bool Animation::advancePlayhead(float deltaTime) {
+    float duration = getDuration();
+    float next = playhead + deltaTime * playbackSpeed * playDirection;
+
+    switch (playbackMode) {
+    case PlaybackMode::ONCE:
+        if (next >= duration) {
+            next = duration;
+            playing = false;
+        }
+        playhead = std::max(next, 0.0f);
+        return false;
+
+    case PlaybackMode::LOOP:
+        if (duration <= 0.0f) {
+            playhead = 0.0f;
+            return false;
+        }
+        if (next >= duration || next < 0.0f) {
+            next = std::fmod(next, duration);
+            playhead = next < 0.0f ? next + duration : next;
+            return true;
+        }
+        playhead = next;
+        return false;
+
+    case PlaybackMode::PING_PONG:
+        if (duration <= 0.0f) {
+            playhead = 0.0f;
+            return false;
+        }
+        // Reflect off both ends; channels just see the direction change
+        for (int bounce = 0; bounce < 2 && (next > duration || next < 0.0f); ++bounce) {
+            if (next > duration) {
+                next = 2.0f * duration - next;
+                playDirection = -1.0f;
+            }
+            else if (next < 0.0f) {
+                next = -next;
+                playDirection = 1.0f;
+            }
+        }
+        playhead = std::min(std::max(next, 0.0f), duration);
+        return false;
+    }
+    return false;
 }
 
 void Animation::update(float deltaTime) {
-    for (auto& channel : channels) {
-        channel->update(deltaTime);            
+    TRACE_SCOPE("Animation::update");
+    ++frameCounter;
+    elapsedTime += deltaTime;
+
+    float previousPlayhead = playhead;
+    bool jumped = seekPending;
+    seekPending = false;
+    if (playing) {
+        jumped = advancePlayhead(deltaTime) || jumped;
+    }
+    if (!jumped && playhead == previousPlayhead) {
+        return; // Paused: every channel is still where it was
+    }
+
+    // Each channel follows the playhead in its own local time
+    Profiler& profiler = Profiler::getInstance();
+    bool profiling = profiler.isEnabled();
+    auto step = [this, jumped, previousPlayhead, &profiler, profiling](Channel& channel) {
+        double startUs = profiling ? profiler.nowUs() : 0.0;
+        if (jumped) {
+            channel.seek(channel.toLocalTime(playhead));
+        }
+        else {
+            channel.update(channel.toLocalTime(playhead) - channel.toLocalTime(previousPlayhead));
+        }
+        if (profiling) {
+            profiler.recordUpdate(channel.getName(), startUs, profiler.nowUs());
+        }
+    };
+
+    std::vector<std::vector<size_t>> dependents;
+    std::vector<int> dependencyCount;
+    std::vector<size_t> order;
+    bool acyclic = buildUpdateOrder(order, dependents, dependencyCount);
+
+    if (!parallelUpdate || channels.size() < 2 || !acyclic) {
+        for (size_t index : order) {
+            step(*channels[index]);
+        }
+        return;
+    }
+
+    // Each channel becomes a job once all of its dependencies finished updating
+    JobSystem& jobs = JobSystem::getInstance();
+    std::vector<std::atomic<int>> pending(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        pending[i].store(dependencyCount[i]);
+    }
+    std::atomic<size_t> remaining(channels.size());
+
+    std::function<void(size_t)> run = [&](size_t index) {
+        step(*channels[index]);
+        for (size_t dependent : dependents[index]) {
+            if (pending[dependent].fetch_sub(1) == 1) {
+                jobs.submit([&run, dependent]() { run(dependent); });
+            }
+        }
+        remaining.fetch_sub(1); // Only after dependents were submitted, so the wait below cannot finish early
+    };
+
+    for (size_t i = 0; i < channels.size(); ++i) {
+        if (dependencyCount[i] == 0) {
+            jobs.submit([&run, i]() { run(i); });
+        }
     }
+
+    jobs.runUntil([&remaining]() { return remaining.load() == 0; });
 }
 
 void Animation::render(const glm::mat4& view, const glm::mat4& projection) {
@@ -50,6 +480,112 @@ void Animation::render(const glm::mat4& view, const glm::mat4& projection) {
     }
 }
 
+void Animation::captureSnapshot(FrameSnapshot& snapshot) const {
+    snapshot.frameIndex = frameCounter;
+    snapshot.time = elapsedTime;
+    snapshot.channels = channels;
+    snapshot.states.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        snapshot.states[i] = channels[i]->captureState();
+    }
+}
+
+void Animation::applyCamera(const FrameSnapshot& snapshot) const {
+    for (const auto& state : snapshot.states) {
+        if (!state.hasCamera) continue;
+
+        Camera& camera = Camera::getInstance();
+        camera.Position = state.cameraPosition;
+        camera.Front = state.cameraFront;
+        camera.Right = glm::normalize(glm::cross(camera.Front, camera.WorldUp));
+        camera.Up = glm::normalize(glm::cross(camera.Right, camera.Front));
+    }
+}
+
+void Animation::evaluate(float time, FrameSnapshot& snapshot) const {
+    snapshot.frameIndex = 0; // Not produced by a simulation step
+    snapshot.time = time;
+    snapshot.channels = channels;
+    snapshot.states.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        snapshot.states[i] = channels[i]->evaluate(time);
+    }
+}
+
+void Animation::renderSnapshot(const FrameSnapshot& snapshot, const glm::mat4& view, const glm::mat4& projection) {
+    TRACE_SCOPE("Animation::renderSnapshot");
+    Profiler& profiler = Profiler::getInstance();
+    for (size_t i = 0; i < snapshot.channels.size(); ++i) {
+        const auto& channel = snapshot.channels[i];
+        if (!channel->isActive) {
+            continue; // Skip rendering if the channel is not active
+        }
+        profiler.beginRender(channel->getName());
+        // Check for background channel
+        if (channel->getType() == BACKGROUND) {
+            channel->renderState(snapshot.states[i], skyboxView, projection);
+        }
+        else {
+            channel->renderState(snapshot.states[i], view, projection);
+        }
+        profiler.endRender();
+    }
+}
+
+void Animation::advance(float frameDeltaTime) {
+    accumulator += std::max(frameDeltaTime, 0.0f);
+    if (accumulator > maxCatchUp) {
+        // A stall (breakpoint, loading) would otherwise be replayed as a burst of steps
+        accumulator = maxCatchUp;
+    }
+    runFixedSteps();
+}
+
+void Animation::advanceExact(float deltaTime) {
+    accumulator += std::max(deltaTime, 0.0f);
+    runFixedSteps();
+}
+
+void Animation::runFixedSteps() {
+    if (currentStep.channels != channels) {
+        captureSnapshot(currentStep); // First call, or the channel list changed
+        previousStep = currentStep;
+    }
+
+    while (accumulator >= fixedStep) {
+        update(fixedStep);
+        std::swap(previousStep, currentStep);
+        captureSnapshot(currentStep);
+        accumulator -= fixedStep;
+    }
+}
+
+void Animation::captureInterpolated(FrameSnapshot& snapshot) const {
+    float alpha = accumulator / fixedStep;
+    snapshot.frameIndex = currentStep.frameIndex;
+    snapshot.time = previousStep.time + (currentStep.time - previousStep.time) * alpha;
+    snapshot.channels = currentStep.channels;
+    snapshot.states.resize(currentStep.states.size());
+    for (size_t i = 0; i < currentStep.states.size(); ++i) {
+        bool sameChannel = i < previousStep.channels.size() && previousStep.channels[i] == currentStep.channels[i];
+        snapshot.states[i] = sameChannel
+            ? interpolateState(previousStep.states[i], currentStep.states[i], alpha)
+            : currentStep.states[i];
+    }
+}
+
+void Animation::setFixedStepRate(float hz) {
+    if (hz > 0.0f) {
+        fixedStep = 1.0f / hz;
+    }
+}
+
+void Animation::resetClock() {
+    accumulator = 0.0f;
+    previousStep = FrameSnapshot();
+    currentStep = FrameSnapshot();
+}
+
 const std::string& Animation::getName() const {
     return name;
 }
@@ -61,5 +597,8 @@ const std::vector<std::shared_ptr<Channel>>& Animation::getChannels() const {
 void Animation::swapChannels(size_t index1, size_t index2) {
     if (index1 < channels.size() && index2 < channels.size()) {
         std::swap(channels[index1], channels[index2]);
+        channelIndices[channels[index1]->getHandle()] = index1;
+        channelIndices[channels[index2]->getHandle()] = index2;
+        orderChangedSinceCommit = true;
     }
 }
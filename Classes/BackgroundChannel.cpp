@@ -1,16 +1,7 @@
 #include "../Headers/BackgroundChannel.h"
 
-// Function to initialize GLAD
-bool initializeGLAD() {
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD" << std::endl;
-        return false;
-    }
-    return true;
-}
-
 BackgroundChannel::BackgroundChannel(const std::string& name)
-    : Channel(name, BACKGROUND), setupCompleted(false), backgroundShader(nullptr) {
+    : Channel(name, BACKGROUND), setupCompleted(false) {
     // Initialization is deferred to the setupBackground method
 }
 
@@ -23,7 +14,17 @@ BackgroundChannel::~BackgroundChannel() {
         glDeleteBuffers(1, &backgroundVBO);
         backgroundVBO = 0; // Avoid dangling reference
     }
-    delete backgroundShader;
+}
+
+std::shared_ptr<Channel> BackgroundChannel::clone() const {
+    auto copy = std::make_shared<BackgroundChannel>(name);
+    copy->copyChannelState(*this);
+    copy->texture = texture; // Cached textures are shared, the quad is set up again by render
+    copy->backgroundShader = backgroundShader;
+    copy->skyboxTexture = skyboxTexture;
+    copy->texturePath = texturePath;
+    copy->skyboxFaces = skyboxFaces;
+    return copy;
 }
 
 void BackgroundChannel::loadTexture(const std::string& texturePath) {
@@ -31,30 +32,10 @@ void BackgroundChannel::loadTexture(const std::string& texturePath) {
         setupBackground();
     }
 
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    // Set the texture wrapping parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    // Set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Load image
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(texturePath.c_str(), &width, &height, &nrChannels, 0);
-    if (data) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        stbi_image_free(data);
-    }
-    else {
-        std::cerr << "Failed to load texture: " << texturePath << std::endl;
-        stbi_image_free(data);
-    }
-
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Reuses the GL texture if another channel already loaded this image;
+    // the previously assigned texture is freed once no channel references it
+    texture = TextureCache::getInstance().loadTexture2D(texturePath);
+    this->texturePath = texturePath;
 }
 
 void BackgroundChannel::loadSkybox(const std::vector<std::string>& faces) {
@@ -62,42 +43,46 @@ void BackgroundChannel::loadSkybox(const std::vector<std::string>& faces) {
         setupBackground();
     }
 
-    glGenTextures(1, &skyboxTextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTextureID);
-
-    int width, height, nrChannels;
-    for (unsigned int i = 0; i < faces.size(); i++) {
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data) {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data
-            );
-            stbi_image_free(data);
+    skyboxTexture = TextureCache::getInstance().loadCubemap(faces);
+    skyboxFaces = faces;
+}
+
+void BackgroundChannel::writeSceneSettings(std::ostream& out) const {
+    if (!texturePath.empty()) {
+        out << "Set Texture: " << texturePath << "\n";
+    }
+    for (const auto& face : skyboxFaces) {
+        out << "Set SkyboxFace: " << face << "\n";
+    }
+}
+
+void BackgroundChannel::readSceneSetting(const std::string& key, const std::string& value) {
+    if (key == "Texture") {
+        loadTexture(value);
+    }
+    else if (key == "SkyboxFace") {
+        // The cubemap is only complete with all six faces
+        std::vector<std::string> faces = skyboxFaces.size() < 6 ? skyboxFaces : std::vector<std::string>();
+        faces.push_back(value);
+        if (faces.size() == 6) {
+            loadSkybox(faces);
         }
         else {
-            std::cerr << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
-            stbi_image_free(data);
+            skyboxFaces = faces;
         }
     }
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
 void BackgroundChannel::setupBackground() {
-    if (!initializeGLAD()) {
-        std::cerr << "Failed to initialize GLAD" << std::endl;
-        return;
+    // GL functions are loaded once by whoever created the context (window or headless)
+    // Check if the shaders are compiled and linked correctly, reporting a failure only once
+    if (!backgroundShader) {
+        backgroundShader = std::make_shared<ShaderD>("../Shaders/background.vs", "../Shaders/background.fs");
+        if (!backgroundShader->isCompiled()) {
+            std::cerr << "Failed to compile and link shader" << std::endl;
+        }
     }
-
-    // Check if the shaders are compiled and linked correctly
-    backgroundShader = new ShaderD("../Shaders/background.vs", "../Shaders/background.fs");
     if (!backgroundShader->isCompiled()) {
-        std::cerr << "Failed to compile and link shader" << std::endl;
         return;
     }
     
@@ -159,8 +144,10 @@ void BackgroundChannel::setupBackground() {
 
 void BackgroundChannel::render(const glm::mat4& view, const glm::mat4& projection) {
     if (!setupCompleted) {
-        std::cerr << "Background setup not completed. Aborting render." << std::endl;
-        return;
+        setupBackground(); // Clones start without a quad of their own
+        if (!setupCompleted) {
+            return;
+        }
     }
 
     glDepthFunc(GL_LEQUAL);  // Change depth function so depth test passes when values are equal to depth buffer's content
@@ -176,7 +163,7 @@ void BackgroundChannel::render(const glm::mat4& view, const glm::mat4& projectio
 
     // Activate the texture unit first before binding texture
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTextureID);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, skyboxTexture ? skyboxTexture->id : 0);
 
     // Set the texture uniform in the shader (usually required)
     GLint textureUniformLocation = glGetUniformLocation(backgroundShader->ID, "ourTexture");
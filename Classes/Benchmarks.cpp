@@ -0,0 +1,333 @@
+#include "../Headers/Benchmarks.h"
+#include "../Headers/Core/CameraPath.h"
+#include "../Headers/Core/FFD.h"
+#include "../Headers/Core/Interpolation.h"
+#include "../Headers/Core/KeyFrameIO.h"
+#include "../Headers/Core/KeyFrameTracks.h"
+#include "../Headers/Core/KeyFrameTrack.h"
+#include "../Headers/Core/Skeleton.h"
+#include "../Headers/Core/SquadTrack.h"
+#include "../Headers/Core/TrackCompression.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BenchmarkResult {
+        std::string name;
+        long long iterations = 0; // Per sample
+        double medianNs = 0.0;    // Per iteration
+        double minNs = 0.0;
+        double maxNs = 0.0;
+    };
+
+    // Written after every iteration so the compiler cannot drop the benchmarked work
+    volatile float benchmarkSink = 0.0f;
+
+    class BenchmarkRunner {
+    public:
+        BenchmarkRunner(const std::string& filter, double minTime) : filter(filter), minTime(minTime) {}
+
+        bool wants(const std::string& name) const {
+            return filter.empty() || name.find(filter) != std::string::npos;
+        }
+
+        // body() runs one iteration and returns a value derived from its result
+        template <typename Body>
+        void run(const std::string& name, Body body) {
+            if (!wants(name)) return;
+            using clock = std::chrono::steady_clock;
+
+            // Grow the batch until one batch takes a tenth of the time budget
+            long long batch = 1;
+            while (true) {
+                auto start = clock::now();
+                for (long long i = 0; i < batch; ++i) benchmarkSink = benchmarkSink + body();
+                double seconds = std::chrono::duration<double>(clock::now() - start).count();
+                if (seconds >= minTime / sampleCount || batch >= (1LL << 30)) break;
+                batch *= seconds > 0.0 ? std::max(2LL, std::min(10LL, static_cast<long long>(minTime / sampleCount / seconds) + 1)) : 10;
+            }
+
+            std::vector<double> samples;
+            for (int s = 0; s < sampleCount; ++s) {
+                auto start = clock::now();
+                for (long long i = 0; i < batch; ++i) benchmarkSink = benchmarkSink + body();
+                samples.push_back(std::chrono::duration<double, std::nano>(clock::now() - start).count() / batch);
+            }
+            std::sort(samples.begin(), samples.end());
+
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = batch;
+            result.medianNs = samples[samples.size() / 2];
+            result.minNs = samples.front();
+            result.maxNs = samples.back();
+            results.push_back(result);
+
+            std::cout << std::left << std::setw(56) << name << std::right << std::setw(14) << std::fixed << std::setprecision(1)
+                << result.medianNs << " ns" << std::setw(14) << result.minNs << " ns" << std::setw(12) << batch << std::endl;
+        }
+
+        const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+    private:
+        static const int sampleCount = 10;
+        std::string filter;
+        double minTime;
+        std::vector<BenchmarkResult> results;
+    };
+
+    // Deterministic pseudo-random numbers so every run benchmarks the same data
+    struct Lcg {
+        unsigned int state = 12345u;
+        float next() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        }
+        glm::vec3 nextVec3(float extent) {
+            return glm::vec3(next() - 0.5f, next() - 0.5f, next() - 0.5f) * (2.0f * extent);
+        }
+    };
+
+    std::vector<KeyFrame> makeKeyFrames(size_t count, size_t controlPointCount, Lcg& random) {
+        std::vector<KeyFrame> keyFrames;
+        for (size_t i = 0; i < count; ++i) {
+            KeyFrame keyFrame(static_cast<float>(i), random.nextVec3(10.0f),
+                glm::normalize(glm::quat(random.next(), random.next(), random.next(), random.next())), glm::vec3(1.0f));
+            for (size_t c = 0; c < controlPointCount; ++c) {
+                glm::vec3 original = random.nextVec3(1.0f);
+                keyFrame.ffdControlPoints.push_back(FFDControlPoint(original + random.nextVec3(0.2f), original, 1.0f));
+            }
+            keyFrames.push_back(keyFrame);
+        }
+        return keyFrames;
+    }
+
+    void benchmarkCamera(BenchmarkRunner& runner, Lcg& random) {
+        for (size_t keyFrameCount : { 4, 8, 16, 32 }) {
+            std::vector<KeyFrame> keyFrames = makeKeyFrames(keyFrameCount, 0, random);
+            CameraPath path;
+            runner.run("CameraPath/build/" + std::to_string(keyFrameCount), [&]() {
+                path.build(keyFrames); // Arc-length table
+                return path.getLength();
+            });
+            runner.run("CameraPath/sample/" + std::to_string(keyFrameCount), [&]() {
+                return static_cast<float>(path.sample(24.0f).size());
+            });
+            runner.run("CameraPath/tessellate/" + std::to_string(keyFrameCount), [&]() {
+                return static_cast<float>(path.tessellate(PathTolerance()).size());
+            });
+        }
+
+        for (size_t pointCount : { 4, 16, 64 }) {
+            std::vector<glm::vec3> points;
+            for (size_t i = 0; i < pointCount; ++i) points.push_back(random.nextVec3(10.0f));
+            float t = 0.0f;
+            runner.run("Interpolation/bezierInterpolate/vec3/" + std::to_string(pointCount), [&]() {
+                t = t >= 1.0f ? 0.0f : t + 0.001f;
+                return bezierInterpolate(points, t).x;
+            });
+        }
+        for (size_t pointCount : { 4, 16 }) {
+            std::vector<glm::quat> points;
+            for (size_t i = 0; i < pointCount; ++i) {
+                points.push_back(glm::normalize(glm::quat(random.next(), random.next(), random.next(), random.next())));
+            }
+            float t = 0.0f;
+            runner.run("Interpolation/bezierInterpolate/quat/" + std::to_string(pointCount), [&]() {
+                t = t >= 1.0f ? 0.0f : t + 0.001f;
+                return bezierInterpolate(points, t).w;
+            });
+
+            SquadTrack track;
+            track.build(points);
+            float time = 0.0f;
+            runner.run("SquadTrack/evaluate/" + std::to_string(pointCount), [&]() {
+                time = time >= pointCount - 1 ? 0.0f : time + 0.001f;
+                size_t segment = static_cast<size_t>(time);
+                return track.evaluate(segment, time - segment).w;
+            });
+        }
+    }
+
+    void benchmarkSegmentSearch(BenchmarkRunner& runner, Lcg& random) {
+        for (size_t keyFrameCount : { 8, 64, 512 }) {
+            std::vector<KeyFrame> keyFrames = makeKeyFrames(keyFrameCount, 0, random);
+            float duration = static_cast<float>(keyFrameCount - 1);
+            float time = 0.0f;
+            runner.run("KeyFrameTrack/findKeyFrameSegment/" + std::to_string(keyFrameCount), [&]() {
+                time += 0.37f; // Sweeps every segment in irregular steps
+                if (time > duration) time -= duration;
+                size_t index = 0;
+                float t = 0.0f;
+                findKeyFrameSegment(keyFrames, time, index, t);
+                return static_cast<float>(index) + t;
+            });
+
+            KeyFrameTracks tracks;
+            tracks.build(keyFrames);
+            runner.run("KeyFrameTracks/samplePosition/" + std::to_string(keyFrameCount), [&]() {
+                time += 0.37f;
+                if (time > duration) time -= duration;
+                return tracks.samplePosition(time).x;
+            });
+        }
+    }
+
+    // A smooth 120 Hz take, the kind of track compression is meant for
+    std::vector<KeyFrame> makeCaptureTake(size_t count) {
+        std::vector<KeyFrame> keyFrames;
+        for (size_t i = 0; i < count; ++i) {
+            float time = i / 120.0f;
+            glm::vec3 position(std::sin(time), 0.5f * time, std::cos(0.3f * time));
+            glm::quat rotation = glm::angleAxis(0.3f * time, glm::normalize(glm::vec3(0.6f, 0.8f, 0.0f)));
+            keyFrames.emplace_back(time, position, rotation, glm::vec3(1.0f));
+        }
+        return keyFrames;
+    }
+
+    void benchmarkTrackCompression(BenchmarkRunner& runner) {
+        for (size_t keyFrameCount : { 1000, 10000 }) {
+            std::vector<KeyFrame> keyFrames = makeCaptureTake(keyFrameCount);
+            CompressedTrack track;
+            runner.run("TrackCompression/compress/" + std::to_string(keyFrameCount), [&]() {
+                track = CompressedTrack::compress(keyFrames, CompressionTolerance());
+                return static_cast<float>(track.getByteSize());
+            });
+
+            float duration = keyFrames.back().timestamp;
+            float time = 0.0f;
+            runner.run("TrackCompression/sample/" + std::to_string(keyFrameCount), [&]() {
+                time += 0.037f;
+                if (time > duration) time -= duration;
+                return track.samplePosition(time).x + track.sampleRotation(time).w + track.sampleScale(time).x;
+            });
+        }
+    }
+
+    void benchmarkFFD(BenchmarkRunner& runner, Lcg& random) {
+        for (size_t vertexCount : { 1000, 10000, 100000 }) {
+            std::vector<glm::vec3> restPositions;
+            for (size_t v = 0; v < vertexCount; ++v) {
+                restPositions.push_back(random.nextVec3(1.0f));
+            }
+            std::vector<const std::vector<glm::vec3>*> restMeshes = { &restPositions };
+            for (size_t controlPointCount : { 4, 16, 64 }) {
+                std::vector<FFDControlPoint> controlPoints = makeKeyFrames(1, controlPointCount, random).front().ffdControlPoints;
+                DeformedPositions deformed;
+                runner.run("FFD/deformFFD/" + std::to_string(vertexCount) + "v/" + std::to_string(controlPointCount) + "cp", [&]() {
+                    deformFFD(restMeshes, controlPoints, deformed);
+                    return deformed[0][0].x;
+                });
+            }
+        }
+    }
+
+    void benchmarkKeyFrameLoading(BenchmarkRunner& runner, Lcg& random) {
+        for (size_t keyFrameCount : { 10, 100, 1000, 10000 }) {
+            std::string name = "KeyFrameIO/parseKeyFrames/" + std::to_string(keyFrameCount);
+            if (!runner.wants(name)) continue;
+
+            std::string path = "bench_keyframes_" + std::to_string(keyFrameCount) + ".txt";
+            {
+                std::ofstream out(path, std::ios::trunc);
+                writeKeyFrames(out, makeKeyFrames(keyFrameCount, 8, random));
+            }
+
+            // Includes opening the file, like Channel::loadKeyFramesFromFile
+            runner.run(name, [&]() {
+                std::ifstream in(path);
+                return static_cast<float>(parseKeyFrames(in).size());
+            });
+            std::remove(path.c_str());
+        }
+    }
+
+    void benchmarkSkeleton(BenchmarkRunner& runner) {
+        std::vector<Joint> skeleton = createStickFigureSkeleton();
+        std::vector<glm::mat4> worldMatrices;
+        float angle = 0.0f;
+        runner.run("Skeleton/computeJointMatrices", [&]() {
+            angle += 0.01f;
+            skeleton[2].rotation = glm::angleAxis(angle, glm::vec3(0.0f, 0.0f, 1.0f)); // Swing the left arm
+            computeJointMatrices(skeleton, worldMatrices);
+            return worldMatrices.back()[3].x;
+        });
+    }
+
+    bool writeJson(const std::string& path, const std::vector<BenchmarkResult>& results, double minTime) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open benchmark output: " << path << std::endl;
+            return false;
+        }
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"min_time\": " << minTime << ",\n"
+#ifdef NDEBUG
+            << "    \"library_build_type\": \"release\"\n"
+#else
+            << "    \"library_build_type\": \"debug\"\n"
+#endif
+            << "  },\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& result = results[i];
+            out << "    {\"name\": \"" << result.name << "\", \"run_type\": \"iteration\", \"iterations\": " << result.iterations
+                << ", \"real_time\": " << result.medianNs << ", \"cpu_time\": " << result.medianNs
+                << ", \"min_time\": " << result.minNs << ", \"max_time\": " << result.maxNs
+                << ", \"time_unit\": \"ns\"}" << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        return out.good();
+    }
+}
+
+int runBenchmarks(int argc, char** argv) {
+    std::string filter;
+    std::string outputPath;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench-filter" && hasValue) filter = argv[++i];
+        else if (arg == "--bench-out" && hasValue) outputPath = argv[++i];
+        else if (arg == "--bench-min-time" && hasValue) minTime = std::max(0.01, std::atof(argv[++i]));
+    }
+
+#ifndef NDEBUG
+    std::cout << "Warning: benchmarks built without NDEBUG, timings are not representative" << std::endl;
+#endif
+    std::cout << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(17) << "Median" << std::setw(17) << "Min"
+        << std::setw(12) << "Iterations" << std::endl;
+
+    BenchmarkRunner runner(filter, minTime);
+    Lcg random;
+    benchmarkCamera(runner, random);
+    benchmarkSegmentSearch(runner, random);
+    benchmarkTrackCompression(runner);
+    benchmarkFFD(runner, random);
+    benchmarkKeyFrameLoading(runner, random);
+    benchmarkSkeleton(runner);
+
+    if (!outputPath.empty() && !writeJson(outputPath, runner.getResults(), minTime)) {
+        return -1;
+    }
+    return 0;
+}
@@ -1,4 +1,42 @@
 #include "../Headers/Channel.h"
+#include "../Headers/FrameCache.h"
+#include "../Headers/Core/KeyFrameIO.h"
+#include "../Headers/Trace.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    std::atomic<uint64_t> nextChannelId{ 1 };
+    std::atomic<uint64_t> nextChannelVersion{ 1 };
+}
+
+Channel::Channel(const std::string& name, ChannelType type)
+    : name(name), channelType(type), id(nextChannelId++) {}
+
+void Channel::markChanged() {
+    version = nextChannelVersion++;
+    tracks.build(keyFrames);
+    onChanged();
+}
+
+void Channel::copyChannelState(const Channel& source) {
+    name = source.name;
+    channelType = source.channelType;
+    keyFrames = source.keyFrames;
+    tracks = source.tracks;
+    frameRate = source.frameRate;
+    timeOffset = source.timeOffset;
+    timeScale = source.timeScale;
+    animationFinished = source.animationFinished;
+    isActive = source.isActive;
+    dependencies = source.dependencies;
+    id = source.id;
+    version = source.version;
+}
+
+ChannelState Channel::evaluateCached(float localTime) const {
+    return FrameCache::getInstance().evaluate(*this, localTime);
+}
 
 std::string Channel::getTypeString() const {
     switch (channelType) {
@@ -10,95 +48,65 @@ std::string Channel::getTypeString() const {
     }
 }
 
+float Channel::getEndTime() const {
+    if (keyFrames.empty() || timeScale <= 0.0f) return timeOffset;
+    return timeOffset + keyFrames.back().timestamp / timeScale;
+}
+
 void Channel::swapKeyFrames(size_t index1, size_t index2) {
     if (index1 < keyFrames.size() && index2 < keyFrames.size()) {
         KeyFrame temp = keyFrames[index1];
         keyFrames[index1] = keyFrames[index2];
         keyFrames[index2] = temp;
+        markChanged(); // After the edit: derived tracks are rebuilt from the new keys
     }
 }
 
 void Channel::updateKeyFrame(size_t index, const KeyFrame& keyFrame) {
     if (index < keyFrames.size()) {
         keyFrames[index] = keyFrame;
+        markChanged();
     }
 }
 
 void Channel::removeKeyFrame(size_t index) {
     if (index < keyFrames.size()) {
         keyFrames.erase(keyFrames.begin() + index);
+        markChanged();
     }
 }
 
+void Channel::addDependency(ChannelHandle handle) {
+    if (handle == INVALID_CHANNEL_HANDLE || handle == id || dependsOn(handle)) return;
+    dependencies.push_back(handle);
+}
+
+void Channel::removeDependency(ChannelHandle handle) {
+    dependencies.erase(std::remove(dependencies.begin(), dependencies.end(), handle), dependencies.end());
+}
+
+bool Channel::dependsOn(ChannelHandle handle) const {
+    return std::find(dependencies.begin(), dependencies.end(), handle) != dependencies.end();
+}
+
 void Channel::loadKeyFramesFromFile(const std::string& filePath) {
+    TRACE_SCOPE("Channel::loadKeyFramesFromFile");
     std::ifstream file(filePath);
     if (!file.is_open()) {
         std::cerr << "Failed to open keyframe file: " << filePath << std::endl;
         return;
     }
 
-    std::string line;
-    KeyFrame keyFrame;
-    bool firstKeyFrame = true;
-    while (std::getline(file, line)) {
-        // Remove leading and trailing whitespace
-        line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](unsigned char ch) {
-            return !std::isspace(ch);
-            }));
-        line.erase(std::find_if(line.rbegin(), line.rend(), [](unsigned char ch) {
-            return !std::isspace(ch);
-            }).base(), line.end());
-
-        std::istringstream iss(line);
-
-        if (line.find("KeyFrame") != std::string::npos) {
-            if (!firstKeyFrame) {
-                keyFrames.push_back(keyFrame);
-                keyFrame = KeyFrame(); // Reset for the next keyframe
-            }
-            else {
-                firstKeyFrame = false;
-            }
-        }
-        else if (line.find("Control Point") != std::string::npos) {
-            FFDControlPoint controlPoint;
-            int controlPointIndex;
-            int matched = sscanf_s(line.c_str(), "Control Point %d: Position (%f, %f, %f), Original Position (%f, %f, %f), Weight %f",
-                &controlPointIndex,
-                &controlPoint.position.x, &controlPoint.position.y, &controlPoint.position.z,
-                &controlPoint.originalPosition.x, &controlPoint.originalPosition.y, &controlPoint.originalPosition.z,
-                &controlPoint.weight);
-
-            if (matched == 8) {
-                keyFrame.ffdControlPoints.push_back(controlPoint);
-            }
-        }
-        else if (line.find("Timestamp") != std::string::npos) {
-            float timestamp;
-            sscanf_s(line.c_str(), "Timestamp: %f", &timestamp);
-            keyFrame.timestamp = timestamp;
-        }
-        else if (line.find("Position") != std::string::npos) {
-            float x, y, z;
-            sscanf_s(line.c_str(), "Position: (%f, %f, %f)", &x, &y, &z);
-            keyFrame.position = glm::vec3(x, y, z);
-        }
-        else if (line.find("Orientation") != std::string::npos) {
-            float x, y, z, w;
-            sscanf_s(line.c_str(), "Orientation: (%f, %f, %f, %f)", &x, &y, &z, &w);
-            keyFrame.rotation = glm::quat(w, x, y, z);
-        }
-        else if (line.find("Scale") != std::string::npos) {
-            float x, y, z;
-            sscanf_s(line.c_str(), "Scale: (%f, %f, %f)", &x, &y, &z);
-            keyFrame.scale = glm::vec3(x, y, z);
-        }
-    }
+    loadKeyFrames(file);
+    file.close();
+}
 
-    // Add the last keyframe if the file was read successfully
-    if (!firstKeyFrame) {
-        keyFrames.push_back(keyFrame);
-    }
+void Channel::loadKeyFrames(std::istream& file) {
+    std::vector<KeyFrame> loaded = parseKeyFrames(file);
+    keyFrames.insert(keyFrames.end(), loaded.begin(), loaded.end());
+    markChanged();
+}
 
-    file.close();
+void Channel::saveKeyFrames(std::ostream& out) const {
+    writeKeyFrames(out, keyFrames);
 }
@@ -8,8 +8,17 @@ CharacterAnimationChannel::CharacterAnimationChannel(const std::string& name)
     interpolatedRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
     interpolatedScale = glm::vec3(1.0f);
 
-    // Create and initialize the StickFigure character
-    character = new StickFigure();
+    // The StickFigure character is created on first render and shared with clones
+}
+
+std::shared_ptr<Channel> CharacterAnimationChannel::clone() const {
+    auto copy = std::make_shared<CharacterAnimationChannel>(name);
+    copy->copyChannelState(*this);
+    copy->character = character;
+    copy->interpolatedPosition = interpolatedPosition;
+    copy->interpolatedRotation = interpolatedRotation;
+    copy->interpolatedScale = interpolatedScale;
+    return copy;
 }
 
 void CharacterAnimationChannel::update(float deltaTime) {
@@ -17,7 +26,9 @@ void CharacterAnimationChannel::update(float deltaTime) {
 }
 
 void CharacterAnimationChannel::render(const glm::mat4& view, const glm::mat4& projection) {
-    if (!character) return;
+    if (!character) {
+        character = std::make_shared<StickFigure>();
+    }
     // implementation
 
     character->render(view, projection);
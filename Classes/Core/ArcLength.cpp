@@ -0,0 +1,96 @@
+#include "../../Headers/Core/ArcLength.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 5-point Gauss-Legendre nodes and weights on [-1, 1]
+    const float nodes[5] = { 0.0f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f };
+    const float weights[5] = { 0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f };
+
+    float gaussLegendre(const std::function<float(float)>& f, float a, float b) {
+        float halfWidth = 0.5f * (b - a);
+        float center = 0.5f * (a + b);
+        float sum = 0.0f;
+        for (int i = 0; i < 5; ++i) {
+            sum += weights[i] * f(center + halfWidth * nodes[i]);
+        }
+        return sum * halfWidth;
+    }
+
+    float adaptive(const std::function<float(float)>& f, float a, float b, float whole, float tolerance, int depth) {
+        float middle = 0.5f * (a + b);
+        float left = gaussLegendre(f, a, middle);
+        float right = gaussLegendre(f, middle, b);
+        if (depth <= 0 || std::abs(left + right - whole) <= tolerance) {
+            return left + right;
+        }
+        return adaptive(f, a, middle, left, 0.5f * tolerance, depth - 1)
+            + adaptive(f, middle, b, right, 0.5f * tolerance, depth - 1);
+    }
+}
+
+float integrateGaussLegendre(const std::function<float(float)>& f, float a, float b, float tolerance, int maxDepth) {
+    return adaptive(f, a, b, gaussLegendre(f, a, b), tolerance, maxDepth);
+}
+
+void ArcLengthTable::build(const std::function<float(float)>& speed, int intervals, float tolerance) {
+    intervals = std::max(intervals, 1);
+    distances.assign(intervals + 1, 0.0f);
+    for (int i = 0; i < intervals; ++i) {
+        float a = static_cast<float>(i) / intervals;
+        float b = static_cast<float>(i + 1) / intervals;
+        distances[i + 1] = distances[i] + integrateGaussLegendre(speed, a, b, tolerance / intervals);
+    }
+}
+
+void ArcLengthTable::clear() {
+    distances.clear();
+}
+
+float ArcLengthTable::distanceAtParameter(float u) const {
+    if (distances.size() < 2) return 0.0f;
+
+    float scaled = std::min(std::max(u, 0.0f), 1.0f) * (distances.size() - 1);
+    size_t i = std::min(static_cast<size_t>(scaled), distances.size() - 2);
+    return distances[i] + (scaled - i) * (distances[i + 1] - distances[i]);
+}
+
+float ArcLengthTable::parameterAtDistance(float distance) const {
+    if (distances.size() < 2 || distances.back() <= 0.0f) return 0.0f;
+    if (distance <= 0.0f) return 0.0f;
+    if (distance >= distances.back()) return 1.0f;
+
+    // First table entry past the distance; the curve is treated as linear in between
+    size_t upper = std::upper_bound(distances.begin(), distances.end(), distance) - distances.begin();
+    return parameterInInterval(upper - 1, distance);
+}
+
+float ArcLengthTable::parameterAtDistance(float distance, size_t& cursor) const {
+    if (distances.size() < 2 || distances.back() <= 0.0f) return 0.0f;
+    if (distance <= 0.0f) { cursor = 0; return 0.0f; }
+    if (distance >= distances.back()) { cursor = distances.size() - 2; return 1.0f; }
+
+    // Walk a few intervals from the last one, fall back to the binary search for big jumps
+    size_t lower = std::min(cursor, distances.size() - 2);
+    for (int steps = 0; steps < 4; ++steps) {
+        if (distance < distances[lower]) {
+            --lower;
+        }
+        else if (distance >= distances[lower + 1]) {
+            ++lower;
+        }
+        else {
+            cursor = lower;
+            return parameterInInterval(lower, distance);
+        }
+    }
+    cursor = std::upper_bound(distances.begin(), distances.end(), distance) - distances.begin() - 1;
+    return parameterInInterval(cursor, distance);
+}
+
+float ArcLengthTable::parameterInInterval(size_t lower, float distance) const {
+    float span = distances[lower + 1] - distances[lower];
+    float fraction = span > 0.0f ? (distance - distances[lower]) / span : 0.0f;
+    return (lower + fraction) / (distances.size() - 1);
+}
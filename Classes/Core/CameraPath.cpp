@@ -0,0 +1,163 @@
+#include "../../Headers/Core/CameraPath.h"
+#include "../../Headers/Core/Interpolation.h"
+
+#include <algorithm>
+
+void CameraPath::build(const std::vector<KeyFrame>& keyFrames) {
+    this->keyFrames = keyFrames;
+    positions.clear();
+    std::vector<glm::quat> orientations;
+    for (const auto& keyFrame : keyFrames) {
+        positions.push_back(keyFrame.position);
+        orientations.push_back(keyFrame.rotation);
+    }
+    rotations.build(orientations);
+
+    if (positions.size() < 2) {
+        arcLength.clear();
+        return;
+    }
+    const std::vector<glm::vec3>& controlPoints = positions;
+    arcLength.build([&controlPoints](float u) { return glm::length(bezierDerivative(controlPoints, u)); });
+}
+
+float CameraPath::distanceAt(float time) const {
+    float totalTime = keyFrames.back().timestamp - keyFrames.front().timestamp;
+    if (totalTime <= 0.0f) return arcLength.getLength();
+    float timeFraction = (time - keyFrames.front().timestamp) / totalTime;
+    return speedCurve.distanceFraction(timeFraction) * arcLength.getLength();
+}
+
+float CameraPath::parameterAt(float time) const {
+    if (keyFrames.size() < 2) return 0.0f;
+
+    // time -> distance along the path -> curve parameter
+    return arcLength.parameterAtDistance(distanceAt(time));
+}
+
+float CameraPath::parameterAt(float time, Cursor& cursor) const {
+    if (keyFrames.size() < 2) return 0.0f;
+    return arcLength.parameterAtDistance(distanceAt(time), cursor.arcInterval);
+}
+
+glm::vec3 CameraPath::positionAt(float time) const {
+    if (keyFrames.empty()) return glm::vec3(0.0f);
+    if (time <= keyFrames.front().timestamp) return keyFrames.front().position;
+    if (time >= keyFrames.back().timestamp) return keyFrames.back().position;
+
+    return bezierInterpolate(positions, parameterAt(time));
+}
+
+glm::quat CameraPath::orientationAt(float time) const {
+    if (keyFrames.empty()) return glm::quat();
+    if (time <= keyFrames.front().timestamp) return keyFrames.front().rotation;
+    if (time >= keyFrames.back().timestamp) return keyFrames.back().rotation;
+
+    Cursor cursor;
+    float t;
+    findKeySegment(time, cursor, t);
+    return rotations.evaluate(cursor.keySegment, t);
+}
+
+glm::vec3 CameraPath::scaleAt(float time) const {
+    if (keyFrames.empty()) return glm::vec3(1.0f);
+    if (time <= keyFrames.front().timestamp) return keyFrames.front().scale;
+    if (time >= keyFrames.back().timestamp) return keyFrames.back().scale;
+
+    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
+        if (time >= keyFrames[i].timestamp && time <= keyFrames[i + 1].timestamp) {
+            return glm::mix(keyFrames[i].scale, keyFrames[i + 1].scale, (time - keyFrames[i].timestamp) / (keyFrames[i + 1].timestamp - keyFrames[i].timestamp));
+        }
+    }
+    return glm::vec3(1.0f); // Should never reach here
+}
+
+void CameraPath::poseAt(float time, Cursor& cursor, glm::vec3& position, glm::quat& orientation) const {
+    if (keyFrames.empty()) {
+        position = glm::vec3(0.0f);
+        orientation = glm::quat();
+        return;
+    }
+    if (time <= keyFrames.front().timestamp || time >= keyFrames.back().timestamp) {
+        const KeyFrame& end = time <= keyFrames.front().timestamp ? keyFrames.front() : keyFrames.back();
+        position = end.position;
+        orientation = end.rotation;
+        return;
+    }
+
+    position = bezierInterpolate(positions, parameterAt(time, cursor));
+
+    float t;
+    findKeySegment(time, cursor, t);
+    orientation = rotations.evaluate(cursor.keySegment, t);
+}
+
+void CameraPath::findKeySegment(float time, Cursor& cursor, float& t) const {
+    size_t last = keyFrames.size() - 2; // Callers guarantee two keyframes and a time inside the path
+    size_t& segment = cursor.keySegment;
+    segment = std::min(segment, last);
+    while (segment > 0 && time < keyFrames[segment].timestamp) --segment;
+    while (segment < last && time > keyFrames[segment + 1].timestamp) ++segment;
+
+    float span = keyFrames[segment + 1].timestamp - keyFrames[segment].timestamp;
+    t = span > 0.0f ? std::min(std::max((time - keyFrames[segment].timestamp) / span, 0.0f), 1.0f) : 1.0f;
+}
+
+float CameraPath::speedAt(float time) const {
+    if (keyFrames.size() < 2) return 0.0f;
+
+    float totalTime = keyFrames.back().timestamp - keyFrames.front().timestamp;
+    if (totalTime <= 0.0f || time < keyFrames.front().timestamp || time > keyFrames.back().timestamp) return 0.0f;
+
+    // d(distance)/d(time) = length * d(distanceFraction)/d(timeFraction) / totalTime
+    float timeFraction = (time - keyFrames.front().timestamp) / totalTime;
+    return arcLength.getLength() * speedCurve.distanceRate(timeFraction) / totalTime;
+}
+
+std::vector<glm::vec2> CameraPath::speedProfile(int sampleCount) const {
+    std::vector<glm::vec2> profile;
+    if (keyFrames.size() < 2 || sampleCount < 2) return profile;
+
+    float startTime = getStartTime();
+    float step = (getEndTime() - startTime) / (sampleCount - 1);
+    profile.reserve(sampleCount);
+    for (int i = 0; i < sampleCount; ++i) {
+        float time = startTime + i * step;
+        profile.emplace_back(time, speedAt(time));
+    }
+    return profile;
+}
+
+std::vector<KeyFrame> CameraPath::sample(float frameRate) const {
+    std::vector<KeyFrame> samples;
+
+    if (keyFrames.empty()) return samples;
+
+    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
+        if (i == 0) {
+            samples.push_back(keyFrames[i]);
+        }
+        float startTime = keyFrames[i].timestamp;
+        float endTime = keyFrames[i + 1].timestamp;
+        float interval = (endTime - startTime) / frameRate;
+
+        for (int j = 1; j < frameRate; ++j) {
+            float currentTime = startTime + j * interval;
+            samples.emplace_back(currentTime, positionAt(currentTime), orientationAt(currentTime), scaleAt(currentTime));
+        }
+    }
+
+    samples.push_back(keyFrames.back());
+    return samples;
+}
+
+std::vector<glm::vec3> CameraPath::tessellate(const PathTolerance& tolerance) const {
+    if (positions.size() < 2) return positions;
+
+    const std::vector<glm::vec3>& controlPoints = positions;
+    int initialSpans = std::max(4, 2 * static_cast<int>(controlPoints.size() - 1));
+    return tessellateCurve(
+        [&controlPoints](float u) { return bezierInterpolate(controlPoints, u); },
+        [&controlPoints](float u) { return bezierDerivative(controlPoints, u); },
+        initialSpans, tolerance);
+}
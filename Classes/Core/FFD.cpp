@@ -0,0 +1,48 @@
+#include "../../Headers/Core/FFD.h"
+
+void deformFFD(const std::vector<const std::vector<glm::vec3>*>& restMeshes, const std::vector<FFDControlPoint>& controlPoints, DeformedPositions& deformed) {
+    deformed.resize(restMeshes.size());
+
+    glm::vec3 centerOfMassBefore = glm::vec3(0.0f);
+    glm::vec3 centerOfMassAfter = glm::vec3(0.0f);
+    size_t totalVertices = 0;
+
+    // Apply FFD to the model vertices using control points
+    for (size_t m = 0; m < restMeshes.size(); ++m) {
+        const auto& restPositions = *restMeshes[m];
+        auto& positions = deformed[m];
+        positions.resize(restPositions.size());
+        totalVertices += restPositions.size();
+
+        for (size_t v = 0; v < restPositions.size(); ++v) {
+            glm::vec3 originalPosition = restPositions[v];
+            glm::vec3 displacement = glm::vec3(0.0f);
+            float totalWeight = 0.0f;
+
+            for (const auto& cp : controlPoints) {
+                float distance = glm::length(originalPosition - cp.originalPosition);
+                float weight = cp.weight / (distance + 1.0f);
+                displacement += weight * (cp.position - cp.originalPosition);
+                totalWeight += weight;
+            }
+
+            if (totalWeight > 0.0f) {
+                displacement /= totalWeight;
+            }
+
+            positions[v] = originalPosition + displacement;
+            centerOfMassBefore += originalPosition;
+            centerOfMassAfter += positions[v];
+        }
+    }
+    if (totalVertices == 0) return;
+
+    // Adjust vertices to maintain the same center of mass
+    glm::vec3 correction = (centerOfMassBefore - centerOfMassAfter) / static_cast<float>(totalVertices);
+
+    for (auto& positions : deformed) {
+        for (auto& position : positions) {
+            position += correction;
+        }
+    }
+}
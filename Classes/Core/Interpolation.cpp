@@ -0,0 +1,50 @@
+#include "../../Headers/Core/Interpolation.h"
+
+#include <cmath>
+
+// De Casteljau in place on one copy of the control points
+glm::vec3 bezierInterpolate(const std::vector<glm::vec3>& points, float t) {
+    if (points.empty()) {
+        return glm::vec3(0.0f);
+    }
+
+    std::vector<glm::vec3> level = points;
+    for (size_t count = level.size(); count > 1; --count) {
+        for (size_t i = 0; i < count - 1; ++i) {
+            level[i] = glm::mix(level[i], level[i + 1], t);
+        }
+    }
+    return level[0];
+}
+
+glm::quat bezierInterpolate(const std::vector<glm::quat>& points, float t) {
+    if (points.empty()) {
+        return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    std::vector<glm::quat> level = points;
+    for (size_t count = level.size(); count > 1; --count) {
+        for (size_t i = 0; i < count - 1; ++i) {
+            level[i] = glm::slerp(level[i], level[i + 1], t);
+        }
+    }
+    return level[0];
+}
+
+glm::vec3 bezierDerivative(const std::vector<glm::vec3>& points, float t) {
+    if (points.size() < 2) {
+        return glm::vec3(0.0f);
+    }
+
+    // Degree n curve: n times the degree n - 1 curve through the control polygon's edges
+    std::vector<glm::vec3> edges;
+    for (size_t i = 0; i < points.size() - 1; ++i) {
+        edges.push_back(points[i + 1] - points[i]);
+    }
+    return static_cast<float>(edges.size()) * bezierInterpolate(edges, t);
+}
+
+float easeInOutCubic(float t) {
+    float easedValue = t < 0.5f ? 4.0f * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
+    return easedValue;
+}
@@ -0,0 +1,92 @@
+#include "../../Headers/Core/KeyFrameIO.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <string>
+
+std::vector<KeyFrame> parseKeyFrames(std::istream& in) {
+    std::vector<KeyFrame> keyFrames;
+    std::string line;
+    KeyFrame keyFrame;
+    bool firstKeyFrame = true;
+    while (std::getline(in, line)) {
+        // Remove leading and trailing whitespace
+        line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](unsigned char ch) {
+            return !std::isspace(ch);
+            }));
+        line.erase(std::find_if(line.rbegin(), line.rend(), [](unsigned char ch) {
+            return !std::isspace(ch);
+            }).base(), line.end());
+
+        if (line.find("KeyFrame") != std::string::npos) {
+            if (!firstKeyFrame) {
+                keyFrames.push_back(keyFrame);
+                keyFrame = KeyFrame(); // Reset for the next keyframe
+            }
+            else {
+                firstKeyFrame = false;
+            }
+        }
+        else if (line.find("Control Point") != std::string::npos) {
+            FFDControlPoint controlPoint;
+            int controlPointIndex;
+            int matched = std::sscanf(line.c_str(), "Control Point %d: Position (%f, %f, %f), Original Position (%f, %f, %f), Weight %f",
+                &controlPointIndex,
+                &controlPoint.position.x, &controlPoint.position.y, &controlPoint.position.z,
+                &controlPoint.originalPosition.x, &controlPoint.originalPosition.y, &controlPoint.originalPosition.z,
+                &controlPoint.weight);
+
+            if (matched == 8) {
+                keyFrame.ffdControlPoints.push_back(controlPoint);
+            }
+        }
+        else if (line.find("Timestamp") != std::string::npos) {
+            float timestamp;
+            if (std::sscanf(line.c_str(), "Timestamp: %f", &timestamp) == 1) {
+                keyFrame.timestamp = timestamp;
+            }
+        }
+        else if (line.find("Position") != std::string::npos) {
+            float x, y, z;
+            if (std::sscanf(line.c_str(), "Position: (%f, %f, %f)", &x, &y, &z) == 3) {
+                keyFrame.position = glm::vec3(x, y, z);
+            }
+        }
+        else if (line.find("Orientation") != std::string::npos) {
+            float x, y, z, w;
+            if (std::sscanf(line.c_str(), "Orientation: (%f, %f, %f, %f)", &x, &y, &z, &w) == 4) {
+                keyFrame.rotation = glm::quat(w, x, y, z);
+            }
+        }
+        else if (line.find("Scale") != std::string::npos) {
+            float x, y, z;
+            if (std::sscanf(line.c_str(), "Scale: (%f, %f, %f)", &x, &y, &z) == 3) {
+                keyFrame.scale = glm::vec3(x, y, z);
+            }
+        }
+    }
+
+    // Add the last keyframe if the file was read successfully
+    if (!firstKeyFrame) {
+        keyFrames.push_back(keyFrame);
+    }
+    return keyFrames;
+}
+
+void writeKeyFrames(std::ostream& out, const std::vector<KeyFrame>& keyFrames) {
+    for (size_t i = 0; i < keyFrames.size(); ++i) {
+        const KeyFrame& keyFrame = keyFrames[i];
+        out << "KeyFrame " << i << "\n";
+        out << "Timestamp: " << keyFrame.timestamp << "\n";
+        out << "Position: (" << keyFrame.position.x << ", " << keyFrame.position.y << ", " << keyFrame.position.z << ")\n";
+        out << "Orientation: (" << keyFrame.rotation.x << ", " << keyFrame.rotation.y << ", " << keyFrame.rotation.z << ", " << keyFrame.rotation.w << ")\n";
+        out << "Scale: (" << keyFrame.scale.x << ", " << keyFrame.scale.y << ", " << keyFrame.scale.z << ")\n";
+        for (size_t c = 0; c < keyFrame.ffdControlPoints.size(); ++c) {
+            const FFDControlPoint& controlPoint = keyFrame.ffdControlPoints[c];
+            out << "Control Point " << c << ": Position (" << controlPoint.position.x << ", " << controlPoint.position.y << ", " << controlPoint.position.z
+                << "), Original Position (" << controlPoint.originalPosition.x << ", " << controlPoint.originalPosition.y << ", " << controlPoint.originalPosition.z
+                << "), Weight " << controlPoint.weight << "\n";
+        }
+    }
+}
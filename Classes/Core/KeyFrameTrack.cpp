@@ -0,0 +1,18 @@
+#include "../../Headers/Core/KeyFrameTrack.h"
+
+#include <algorithm>
+
+bool findKeyFrameSegment(const std::vector<KeyFrame>& keyFrames, float time, size_t& index, float& t) {
+    if (keyFrames.size() < 2) return false;
+
+    time = std::max(time, keyFrames.front().timestamp);
+    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
+        if (time >= keyFrames[i].timestamp && time <= keyFrames[i + 1].timestamp) {
+            float span = keyFrames[i + 1].timestamp - keyFrames[i].timestamp;
+            index = i;
+            t = span > 0.0f ? (time - keyFrames[i].timestamp) / span : 1.0f;
+            return true;
+        }
+    }
+    return false;
+}
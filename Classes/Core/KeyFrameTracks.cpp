@@ -0,0 +1,139 @@
+#include "../../Headers/Core/KeyFrameTracks.h"
+
+#include <algorithm>
+
+namespace {
+    bool sameControlPoints(const std::vector<FFDControlPoint>& a, const std::vector<FFDControlPoint>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].position != b[i].position || a[i].originalPosition != b[i].originalPosition || a[i].weight != b[i].weight) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Keys deep inside a run of equal values are dropped. Each run keeps its ends and their inner
+    // neighbours, which is what both linear and SQUAD interpolation (whose tangent at a key
+    // depends on the neighbouring keys) need to reproduce the full track exactly. A property
+    // that never changes ends up with a single key.
+    template <typename Equal>
+    std::vector<size_t> changingKeys(const std::vector<KeyFrame>& keyFrames, const Equal& equal) {
+        auto sameAsNext = [&](size_t i) { return i + 1 < keyFrames.size() && equal(keyFrames[i], keyFrames[i + 1]); };
+
+        std::vector<size_t> kept;
+        bool constant = true;
+        for (size_t i = 0; i < keyFrames.size(); ++i) {
+            bool inside = i >= 2 && sameAsNext(i - 2) && sameAsNext(i - 1) && sameAsNext(i) && sameAsNext(i + 1);
+            if (!inside) {
+                kept.push_back(i);
+            }
+            constant = constant && (i == 0 || sameAsNext(i - 1));
+        }
+        if (constant && !kept.empty()) {
+            kept.resize(1);
+        }
+        return kept;
+    }
+}
+
+void KeyFrameTracks::clear() {
+    position.clear();
+    rotation.clear();
+    scale.clear();
+    ffd.clear();
+    controlPoints.clear();
+    startTime = endTime = 0.0f;
+}
+
+void KeyFrameTracks::build(const std::vector<KeyFrame>& keyFrames) {
+    clear();
+    if (keyFrames.empty()) return;
+    startTime = keyFrames.front().timestamp;
+    endTime = keyFrames.back().timestamp;
+
+    auto samePosition = [](const KeyFrame& a, const KeyFrame& b) { return a.position == b.position; };
+    auto sameRotation = [](const KeyFrame& a, const KeyFrame& b) { return a.rotation == b.rotation; };
+    auto sameScale = [](const KeyFrame& a, const KeyFrame& b) { return a.scale == b.scale; };
+    auto sameFFD = [](const KeyFrame& a, const KeyFrame& b) { return sameControlPoints(a.ffdControlPoints, b.ffdControlPoints); };
+
+    for (size_t i : changingKeys(keyFrames, samePosition)) {
+        position.times.push_back(keyFrames[i].timestamp);
+        position.values.push_back(keyFrames[i].position);
+    }
+    for (size_t i : changingKeys(keyFrames, sameRotation)) {
+        rotation.times.push_back(keyFrames[i].timestamp);
+        rotation.values.push_back(keyFrames[i].rotation);
+    }
+    for (size_t i : changingKeys(keyFrames, sameScale)) {
+        scale.times.push_back(keyFrames[i].timestamp);
+        scale.values.push_back(keyFrames[i].scale);
+    }
+    for (size_t i : changingKeys(keyFrames, sameFFD)) {
+        const std::vector<FFDControlPoint>& points = keyFrames[i].ffdControlPoints;
+        ControlPointSpan span;
+        span.offset = static_cast<uint32_t>(controlPoints.size());
+        span.count = static_cast<uint32_t>(points.size());
+        controlPoints.insert(controlPoints.end(), points.begin(), points.end());
+        ffd.times.push_back(keyFrames[i].timestamp);
+        ffd.values.push_back(span);
+    }
+}
+
+size_t KeyFrameTracks::getByteSize() const {
+    size_t bytes = sizeof(KeyFrameTracks);
+    bytes += position.size() * (sizeof(float) + sizeof(glm::vec3));
+    bytes += rotation.size() * (sizeof(float) + sizeof(glm::quat));
+    bytes += scale.size() * (sizeof(float) + sizeof(glm::vec3));
+    bytes += ffd.size() * (sizeof(float) + sizeof(ControlPointSpan));
+    bytes += controlPoints.size() * sizeof(FFDControlPoint);
+    return bytes;
+}
+
+glm::vec3 KeyFrameTracks::samplePosition(float time) const {
+    if (position.isEmpty()) return glm::vec3(0.0f);
+    size_t i;
+    float t;
+    if (!position.findSegment(time, i, t)) return position.values[i];
+    return glm::mix(position.values[i], position.values[i + 1], t);
+}
+
+glm::quat KeyFrameTracks::sampleRotation(float time) const {
+    if (rotation.isEmpty()) return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    size_t i;
+    float t;
+    if (!rotation.findSegment(time, i, t)) return rotation.values[i];
+    return glm::slerp(rotation.values[i], rotation.values[i + 1], t);
+}
+
+glm::vec3 KeyFrameTracks::sampleScale(float time) const {
+    if (scale.isEmpty()) return glm::vec3(1.0f);
+    size_t i;
+    float t;
+    if (!scale.findSegment(time, i, t)) return scale.values[i];
+    return glm::mix(scale.values[i], scale.values[i + 1], t);
+}
+
+void KeyFrameTracks::sampleControlPoints(float time, std::vector<FFDControlPoint>& out) const {
+    out.clear();
+    if (ffd.isEmpty()) return;
+
+    size_t i;
+    float t;
+    if (!ffd.findSegment(time, i, t)) {
+        const ControlPointSpan& span = ffd.values[i];
+        out.assign(controlPoints.begin() + span.offset, controlPoints.begin() + span.offset + span.count);
+        return;
+    }
+
+    const ControlPointSpan& from = ffd.values[i];
+    const ControlPointSpan& to = ffd.values[i + 1];
+    uint32_t count = std::min(from.count, to.count);
+    out.resize(count);
+    for (uint32_t c = 0; c < count; ++c) {
+        const FFDControlPoint& previous = controlPoints[from.offset + c];
+        out[c].position = glm::mix(previous.position, controlPoints[to.offset + c].position, t);
+        out[c].originalPosition = previous.originalPosition;
+        out[c].weight = previous.weight;
+    }
+}
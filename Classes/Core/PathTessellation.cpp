@@ -0,0 +1,79 @@
+#include "../../Headers/Core/PathTessellation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    struct CurveSample {
+        float u;
+        glm::vec3 position;
+        glm::vec3 tangent;
+    };
+
+    class Tessellator {
+    public:
+        Tessellator(const std::function<glm::vec3(float)>& curve, const std::function<glm::vec3(float)>& derivative,
+            const PathTolerance& tolerance, std::vector<glm::vec3>& points)
+            : curve(curve), derivative(derivative), tolerance(tolerance), points(points) {}
+
+        CurveSample sample(float u) const {
+            return { u, curve(u), derivative(u) };
+        }
+
+        // Appends the span's interior points and its end, not its start
+        void subdivide(const CurveSample& start, const CurveSample& end, int depth) {
+            if (depth < tolerance.maxDepth) {
+                CurveSample middle = sample(0.5f * (start.u + end.u));
+                if (!isFlat(start, middle, end)) {
+                    subdivide(start, middle, depth + 1);
+                    subdivide(middle, end, depth + 1);
+                    return;
+                }
+            }
+            points.push_back(end.position);
+        }
+
+    private:
+        bool isFlat(const CurveSample& start, const CurveSample& middle, const CurveSample& end) const {
+            float startLength = glm::length(start.tangent);
+            float endLength = glm::length(end.tangent);
+            if (startLength > 1e-6f && endLength > 1e-6f) {
+                float cosine = glm::dot(start.tangent, end.tangent) / (startLength * endLength);
+                if (std::acos(std::min(std::max(cosine, -1.0f), 1.0f)) > tolerance.angle) return false;
+            }
+
+            glm::vec3 chordMiddle = 0.5f * (start.position + end.position);
+            if (tolerance.pixels > 0.0f) {
+                glm::vec4 a = tolerance.viewProjection * glm::vec4(middle.position, 1.0f);
+                glm::vec4 b = tolerance.viewProjection * glm::vec4(chordMiddle, 1.0f);
+                if (a.w > 1e-4f && b.w > 1e-4f) {
+                    glm::vec2 offset = glm::vec2(a.x / a.w - b.x / b.w, a.y / a.w - b.y / b.w) * 0.5f * tolerance.viewport;
+                    return glm::length(offset) <= tolerance.pixels;
+                }
+                // Behind the camera: nothing on screen to measure, use the world-space bound
+            }
+            return glm::length(middle.position - chordMiddle) <= tolerance.chordal;
+        }
+
+        const std::function<glm::vec3(float)>& curve;
+        const std::function<glm::vec3(float)>& derivative;
+        const PathTolerance& tolerance;
+        std::vector<glm::vec3>& points;
+    };
+}
+
+std::vector<glm::vec3> tessellateCurve(const std::function<glm::vec3(float)>& curve,
+    const std::function<glm::vec3(float)>& derivative, int initialSpans, const PathTolerance& tolerance) {
+    std::vector<glm::vec3> points;
+    Tessellator tessellator(curve, derivative, tolerance, points);
+
+    initialSpans = std::max(initialSpans, 1);
+    CurveSample start = tessellator.sample(0.0f);
+    points.push_back(start.position);
+    for (int i = 1; i <= initialSpans; ++i) {
+        CurveSample end = tessellator.sample(static_cast<float>(i) / initialSpans);
+        tessellator.subdivide(start, end, 0);
+        start = end;
+    }
+    return points;
+}
@@ -0,0 +1,58 @@
+#include "../../Headers/Core/Skeleton.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+Joint createJoint(const std::string& name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    return { name, position, rotation, scale };
+}
+
+std::vector<Joint> createStickFigureSkeleton() {
+    std::vector<Joint> skeleton;
+
+    // Define the skeleton structure with joint names, positions, rotations, and scales
+    skeleton.push_back(createJoint("Head", glm::vec3(0.0f, 0.6f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.7f, 0.5f, 1.5f)));
+    skeleton.push_back(createJoint("Torso", glm::vec3(0.0f, 1.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.5f, 0.5f)));
+    skeleton.push_back(createJoint("Left Arm", glm::vec3(-0.18f, 0.15f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.25f)));
+    skeleton.push_back(createJoint("Right Arm", glm::vec3(0.18f, 0.15f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(-45.0f), glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.25f)));
+    skeleton.push_back(createJoint("Left Leg", glm::vec3(-0.1f, -0.55f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.25f, 0.7f, 0.25f)));
+    skeleton.push_back(createJoint("Right Leg", glm::vec3(0.1f, -0.55f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.25f, 0.7f, 0.25f)));
+
+    // Adding hands as child joints of the arms
+    skeleton.push_back(createJoint("Left Hand", glm::vec3(0.0f, 0.8f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f, 0.7f, 0.5f)));
+    skeleton.push_back(createJoint("Right Hand", glm::vec3(0.0f, 0.8f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f, 0.7f, 0.5f)));
+
+    // Define parent-child relationships
+    skeleton[1].childrenIndices.push_back(0); // Torso -> Head
+    skeleton[1].childrenIndices.push_back(2); // Torso -> Left Arm
+    skeleton[1].childrenIndices.push_back(3); // Torso -> Right Arm
+    skeleton[1].childrenIndices.push_back(4); // Torso -> Left Leg
+    skeleton[1].childrenIndices.push_back(5); // Torso -> Right Leg
+    skeleton[2].childrenIndices.push_back(6); // Left Arm -> Left Hand
+    skeleton[3].childrenIndices.push_back(7); // Right Arm -> Right Hand
+
+    return skeleton;
+}
+
+glm::mat4 getJointModelMatrix(const Joint& joint) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), joint.position);
+    model *= glm::toMat4(joint.rotation);
+    model = glm::scale(model, joint.scale);
+    return model;
+}
+
+namespace {
+    void accumulateJoint(const std::vector<Joint>& skeleton, int jointIndex, const glm::mat4& parentMatrix, std::vector<glm::mat4>& worldMatrices) {
+        const auto& joint = skeleton[jointIndex];
+        worldMatrices[jointIndex] = parentMatrix * getJointModelMatrix(joint);
+        for (int childIndex : joint.childrenIndices) {
+            accumulateJoint(skeleton, childIndex, worldMatrices[jointIndex], worldMatrices);
+        }
+    }
+}
+
+void computeJointMatrices(const std::vector<Joint>& skeleton, std::vector<glm::mat4>& worldMatrices) {
+    worldMatrices.assign(skeleton.size(), glm::mat4(1.0f));
+    if (skeleton.size() > 1) {
+        accumulateJoint(skeleton, 1, glm::mat4(1.0f), worldMatrices); // Start with the torso as the root (index 1)
+    }
+}
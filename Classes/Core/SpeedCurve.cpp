@@ -0,0 +1,51 @@
+#include "../../Headers/Core/SpeedCurve.h"
+#include "../../Headers/Core/Interpolation.h"
+
+#include <algorithm>
+
+float SpeedCurve::distanceFraction(float timeFraction) const {
+    float t = std::min(std::max(timeFraction, 0.0f), 1.0f);
+    switch (profile) {
+    case SpeedProfile::CONSTANT:
+        return t;
+    case SpeedProfile::EASE_IN_OUT:
+        return easeInOutCubic(t);
+    case SpeedProfile::CUSTOM:
+        break;
+    }
+
+    glm::vec2 previous(0.0f, 0.0f);
+    for (const glm::vec2& point : points) {
+        if (point.x <= previous.x) continue; // Ignore points out of time order
+        if (t <= point.x) {
+            return glm::mix(previous.y, point.y, (t - previous.x) / (point.x - previous.x));
+        }
+        previous = point;
+    }
+    return previous.x < 1.0f ? glm::mix(previous.y, 1.0f, (t - previous.x) / (1.0f - previous.x)) : 1.0f;
+}
+
+float SpeedCurve::distanceRate(float timeFraction) const {
+    float t = std::min(std::max(timeFraction, 0.0f), 1.0f);
+    switch (profile) {
+    case SpeedProfile::CONSTANT:
+        return 1.0f;
+    case SpeedProfile::EASE_IN_OUT: {
+        float u = -2.0f * t + 2.0f;
+        return t < 0.5f ? 12.0f * t * t : 3.0f * u * u;
+    }
+    case SpeedProfile::CUSTOM:
+        break;
+    }
+
+    // Slope of the piece containing t
+    glm::vec2 previous(0.0f, 0.0f);
+    for (const glm::vec2& point : points) {
+        if (point.x <= previous.x) continue;
+        if (t <= point.x) {
+            return (point.y - previous.y) / (point.x - previous.x);
+        }
+        previous = point;
+    }
+    return previous.x < 1.0f ? (1.0f - previous.y) / (1.0f - previous.x) : 0.0f;
+}
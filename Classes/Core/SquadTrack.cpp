@@ -0,0 +1,32 @@
+#include "../../Headers/Core/SquadTrack.h"
+
+#include <glm/gtx/quaternion.hpp>
+
+void SquadTrack::build(const std::vector<glm::quat>& rotations) {
+    keys = rotations;
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (glm::dot(keys[i - 1], keys[i]) < 0.0f) {
+            keys[i] = -keys[i]; // Same rotation, but the short way round from the previous key
+        }
+    }
+
+    inner.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (i == 0 || i + 1 == keys.size()) {
+            inner[i] = keys[i]; // Ends: no neighbour to match the tangent to
+            continue;
+        }
+        glm::quat inverse = glm::inverse(keys[i]);
+        glm::quat tangent = (glm::log(inverse * keys[i + 1]) + glm::log(inverse * keys[i - 1])) * -0.25f;
+        inner[i] = glm::normalize(keys[i] * glm::exp(tangent));
+    }
+}
+
+glm::quat SquadTrack::evaluate(size_t segment, float t) const {
+    if (keys.empty()) return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    if (segment + 1 >= keys.size()) return keys.back();
+
+    glm::quat outer = glm::slerp(keys[segment], keys[segment + 1], t);
+    glm::quat control = glm::slerp(inner[segment], inner[segment + 1], t);
+    return glm::slerp(outer, control, 2.0f * t * (1.0f - t));
+}
@@ -0,0 +1,175 @@
+#include "../../Headers/Core/TrackCompression.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float SQRT_HALF = 0.70710678f; // Bound of the three smallest components of a unit quaternion
+    const size_t MAX_SPAN = 256;         // Longest run of keys one retained pair may replace
+
+    float spanFactor(const std::vector<float>& times, size_t from, size_t to, size_t key) {
+        float span = times[to] - times[from];
+        return span > 0.0f ? (times[key] - times[from]) / span : 0.0f;
+    }
+
+    // Greedy forward reduction: extends the span from the last retained key while every key
+    // inside it is reconstructable from the span's ends
+    template <typename Error>
+    std::vector<size_t> reduceKeys(const std::vector<float>& times, const Error& error, float tolerance) {
+        std::vector<size_t> kept;
+        if (times.empty()) return kept;
+
+        kept.push_back(0);
+        size_t anchor = 0;
+        for (size_t next = 2; next < times.size(); ++next) {
+            bool bridged = next - anchor <= MAX_SPAN;
+            for (size_t key = anchor + 1; bridged && key < next; ++key) {
+                bridged = error(anchor, next, key, spanFactor(times, anchor, next, key)) <= tolerance;
+            }
+            if (!bridged) {
+                anchor = next - 1;
+                kept.push_back(anchor);
+            }
+        }
+        if (times.size() > 1) kept.push_back(times.size() - 1);
+        return kept;
+    }
+
+    // Key pair around time; false (with index at the nearest key) outside the keys
+    bool findSpan(const std::vector<float>& times, float time, size_t& index, float& t) {
+        if (time <= times.front()) { index = 0; return false; }
+        if (time >= times.back()) { index = times.size() - 1; return false; }
+
+        index = std::upper_bound(times.begin(), times.end(), time) - times.begin() - 1;
+        float span = times[index + 1] - times[index];
+        t = span > 0.0f ? (time - times[index]) / span : 0.0f;
+        return true;
+    }
+
+    void encodeRotation(glm::quat q, uint16_t* out) {
+        q = glm::normalize(q);
+        float components[4] = { q.x, q.y, q.z, q.w };
+        int largest = 0;
+        for (int i = 1; i < 4; ++i) {
+            if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+        }
+        float sign = components[largest] < 0.0f ? -1.0f : 1.0f; // q and -q are the same rotation
+
+        int word = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (i == largest) continue;
+            float normalized = std::min(std::max(components[i] * sign / SQRT_HALF, -1.0f), 1.0f);
+            out[word++] = static_cast<uint16_t>(std::lround((normalized * 0.5f + 0.5f) * 32766.0f));
+        }
+        // 2 + 3 * 15 bits: the largest component's index goes into the top bits
+        out[0] |= static_cast<uint16_t>((largest & 1) << 15);
+        out[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+    }
+}
+
+glm::vec3 CompressedTrack::Vec3Channel::decode(size_t key) const {
+    const uint16_t* value = &values[key * 3];
+    return minimum + extent * glm::vec3(value[0], value[1], value[2]) / 65535.0f;
+}
+
+glm::vec3 CompressedTrack::Vec3Channel::sample(float time) const {
+    size_t index;
+    float t;
+    if (!findSpan(times, time, index, t)) return decode(index);
+    return glm::mix(decode(index), decode(index + 1), t);
+}
+
+glm::quat CompressedTrack::QuatChannel::decode(size_t key) const {
+    const uint16_t* value = &values[key * 3];
+    int largest = (value[0] >> 15) | ((value[1] >> 15) << 1);
+
+    float components[4];
+    float sumOfSquares = 0.0f;
+    int word = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        components[i] = ((value[word++] & 0x7FFF) / 32766.0f * 2.0f - 1.0f) * SQRT_HALF;
+        sumOfSquares += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+    return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+glm::quat CompressedTrack::QuatChannel::sample(float time) const {
+    size_t index;
+    float t;
+    if (!findSpan(times, time, index, t)) return decode(index);
+    return glm::slerp(decode(index), decode(index + 1), t);
+}
+
+CompressedTrack CompressedTrack::compress(const std::vector<KeyFrame>& keyFrames, const CompressionTolerance& tolerance) {
+    CompressedTrack track;
+    if (keyFrames.empty()) return track;
+
+    std::vector<float> times;
+    for (const auto& keyFrame : keyFrames) {
+        times.push_back(keyFrame.timestamp);
+    }
+
+    auto positionError = [&](size_t from, size_t to, size_t key, float t) {
+        return glm::length(glm::mix(keyFrames[from].position, keyFrames[to].position, t) - keyFrames[key].position);
+    };
+    auto scaleError = [&](size_t from, size_t to, size_t key, float t) {
+        return glm::length(glm::mix(keyFrames[from].scale, keyFrames[to].scale, t) - keyFrames[key].scale);
+    };
+    auto rotationError = [&](size_t from, size_t to, size_t key, float t) {
+        glm::quat reconstructed = glm::slerp(keyFrames[from].rotation, keyFrames[to].rotation, t);
+        float cosine = std::min(std::abs(glm::dot(glm::normalize(reconstructed), glm::normalize(keyFrames[key].rotation))), 1.0f);
+        return 2.0f * std::acos(cosine); // Angle between the two rotations
+    };
+
+    auto encodeVec3 = [&](Vec3Channel& channel, const std::vector<size_t>& kept, glm::vec3 KeyFrame::* property) {
+        glm::vec3 minimum = keyFrames[kept.front()].*property;
+        glm::vec3 maximum = minimum;
+        for (size_t key : kept) {
+            minimum = glm::min(minimum, keyFrames[key].*property);
+            maximum = glm::max(maximum, keyFrames[key].*property);
+        }
+        channel.minimum = minimum;
+        channel.extent = maximum - minimum;
+
+        for (size_t key : kept) {
+            channel.times.push_back(times[key]);
+            glm::vec3 value = keyFrames[key].*property;
+            for (int axis = 0; axis < 3; ++axis) {
+                float normalized = channel.extent[axis] > 0.0f ? (value[axis] - minimum[axis]) / channel.extent[axis] : 0.0f;
+                channel.values.push_back(static_cast<uint16_t>(std::lround(normalized * 65535.0f)));
+            }
+        }
+    };
+
+    encodeVec3(track.positions, reduceKeys(times, positionError, tolerance.position), &KeyFrame::position);
+    encodeVec3(track.scales, reduceKeys(times, scaleError, tolerance.scale), &KeyFrame::scale);
+
+    for (size_t key : reduceKeys(times, rotationError, tolerance.rotation)) {
+        track.rotations.times.push_back(times[key]);
+        track.rotations.values.resize(track.rotations.values.size() + 3);
+        encodeRotation(keyFrames[key].rotation, &track.rotations.values[track.rotations.values.size() - 3]);
+    }
+    return track;
+}
+
+size_t CompressedTrack::getByteSize() const {
+    size_t bytes = sizeof(CompressedTrack);
+    bytes += positions.times.size() * sizeof(float) + positions.values.size() * sizeof(uint16_t);
+    bytes += rotations.times.size() * sizeof(float) + rotations.values.size() * sizeof(uint16_t);
+    bytes += scales.times.size() * sizeof(float) + scales.values.size() * sizeof(uint16_t);
+    return bytes;
+}
+
+glm::vec3 CompressedTrack::samplePosition(float time) const {
+    return positions.times.empty() ? glm::vec3(0.0f) : positions.sample(time);
+}
+
+glm::quat CompressedTrack::sampleRotation(float time) const {
+    return rotations.times.empty() ? glm::quat(1.0f, 0.0f, 0.0f, 0.0f) : rotations.sample(time);
+}
+
+glm::vec3 CompressedTrack::sampleScale(float time) const {
+    return scales.times.empty() ? glm::vec3(1.0f) : scales.sample(time);
+}
@@ -0,0 +1,262 @@
+#include "../Headers/FrameCache.h"
+#include "../Headers/Channel.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Fixed part of a spilled state; followed by meshCount vertex counts and the positions
+    struct SpillHeader {
+        FrameCacheKey key;
+        float position[3];
+        float rotation[4];
+        float scale[3];
+        float cameraPosition[3];
+        float cameraFront[3];
+        uint32_t flags; // 1 = transform, 2 = camera
+        uint32_t meshCount;
+    };
+
+    void storeVec3(float* out, const glm::vec3& value) {
+        out[0] = value.x;
+        out[1] = value.y;
+        out[2] = value.z;
+    }
+
+    size_t alignUp(size_t value) {
+        return (value + 7) & ~static_cast<size_t>(7);
+    }
+}
+
+FrameCache& FrameCache::getInstance() {
+    // Never destroyed, like the other caches: channels may still evaluate during static destruction
+    static FrameCache* instance = new FrameCache();
+    return *instance;
+}
+
+ChannelState FrameCache::evaluate(const Channel& channel, float localTime) {
+    if (!enabled) {
+        return channel.evaluate(localTime);
+    }
+
+    float quantum = timeQuantum;
+    FrameCacheKey key;
+    key.channelId = channel.getId();
+    key.version = channel.getVersion();
+    key.timeTick = static_cast<int64_t>(std::llround(localTime / quantum));
+
+    ChannelState state;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lookupLocked(key, state)) {
+            ++hits;
+            return state;
+        }
+        ++misses;
+    }
+
+    // Evaluated outside the lock; two threads missing the same key just both compute it
+    state = channel.evaluate(static_cast<float>(key.timeTick * static_cast<double>(quantum)));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    insertLocked(key, state);
+    return state;
+}
+
+size_t FrameCache::measure(const ChannelState& state) {
+    size_t bytes = sizeof(Entry);
+    if (state.deformedPositions) {
+        for (const auto& positions : *state.deformedPositions) {
+            bytes += positions.size() * sizeof(glm::vec3);
+        }
+    }
+    return bytes;
+}
+
+bool FrameCache::lookupLocked(const FrameCacheKey& key, ChannelState& state) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        state = it->second->state;
+        return true;
+    }
+    if (unspillLocked(key, state)) {
+        insertLocked(key, state);
+        return true;
+    }
+    return false;
+}
+
+void FrameCache::insertLocked(const FrameCacheKey& key, const ChannelState& state) {
+    if (entries.count(key)) return;
+
+    size_t bytes = measure(state);
+    if (bytes > memoryBudget) return; // Would evict everything else and still not fit
+
+    lru.push_front({ key, state, bytes });
+    entries[key] = lru.begin();
+    residentBytes += bytes;
+    evictLocked();
+}
+
+void FrameCache::evictLocked() {
+    while (residentBytes > memoryBudget && !lru.empty()) {
+        const Entry& victim = lru.back();
+        if (spillFile.isOpen() && victim.state.deformedPositions && !spillIndex.count(victim.key)) {
+            spillLocked(victim);
+        }
+        residentBytes -= victim.bytes;
+        entries.erase(victim.key);
+        lru.pop_back();
+    }
+}
+
+void FrameCache::spillLocked(const Entry& entry) {
+    const DeformedPositions& meshes = *entry.state.deformedPositions;
+    size_t size = sizeof(SpillHeader) + alignUp(meshes.size() * sizeof(uint32_t));
+    for (const auto& positions : meshes) {
+        size += positions.size() * sizeof(glm::vec3);
+    }
+    size = alignUp(size);
+    if (size > spillFile.size()) return;
+
+    if (spillHead + size > spillFile.size()) {
+        spillHead = 0; // Wrap around; the records at the start are the oldest
+    }
+    // Drop the records this write overwrites
+    while (!spillRecords.empty()) {
+        const SpillRecord& oldest = spillRecords.front();
+        bool overlaps = oldest.offset < spillHead + size && oldest.offset + oldest.size > spillHead;
+        if (!overlaps) break;
+        auto indexed = spillIndex.find(oldest.key);
+        if (indexed != spillIndex.end() && indexed->second == oldest.offset) {
+            spillIndex.erase(indexed);
+        }
+        spillRecords.pop_front();
+    }
+
+    unsigned char* out = spillFile.writableData() + spillHead;
+    const ChannelState& state = entry.state;
+    SpillHeader header;
+    header.key = entry.key;
+    storeVec3(header.position, state.position);
+    header.rotation[0] = state.rotation.x;
+    header.rotation[1] = state.rotation.y;
+    header.rotation[2] = state.rotation.z;
+    header.rotation[3] = state.rotation.w;
+    storeVec3(header.scale, state.scale);
+    storeVec3(header.cameraPosition, state.cameraPosition);
+    storeVec3(header.cameraFront, state.cameraFront);
+    header.flags = (state.hasTransform ? 1u : 0u) | (state.hasCamera ? 2u : 0u);
+    header.meshCount = static_cast<uint32_t>(meshes.size());
+    std::memcpy(out, &header, sizeof(header));
+
+    size_t cursor = sizeof(SpillHeader);
+    for (const auto& positions : meshes) {
+        uint32_t count = static_cast<uint32_t>(positions.size());
+        std::memcpy(out + cursor, &count, sizeof(count));
+        cursor += sizeof(count);
+    }
+    cursor = sizeof(SpillHeader) + alignUp(meshes.size() * sizeof(uint32_t));
+    for (const auto& positions : meshes) {
+        std::memcpy(out + cursor, positions.data(), positions.size() * sizeof(glm::vec3));
+        cursor += positions.size() * sizeof(glm::vec3);
+    }
+
+    spillRecords.push_back({ entry.key, spillHead, size });
+    spillIndex[entry.key] = spillHead;
+    spillHead += size;
+}
+
+bool FrameCache::unspillLocked(const FrameCacheKey& key, ChannelState& state) {
+    auto it = spillIndex.find(key);
+    if (it == spillIndex.end()) return false;
+
+    const unsigned char* in = spillFile.data() + it->second;
+    SpillHeader header;
+    std::memcpy(&header, in, sizeof(header));
+    if (!(header.key == key)) return false;
+
+    state = ChannelState();
+    state.hasTransform = (header.flags & 1u) != 0;
+    state.hasCamera = (header.flags & 2u) != 0;
+    state.position = glm::vec3(header.position[0], header.position[1], header.position[2]);
+    state.rotation = glm::quat(header.rotation[3], header.rotation[0], header.rotation[1], header.rotation[2]);
+    state.scale = glm::vec3(header.scale[0], header.scale[1], header.scale[2]);
+    state.cameraPosition = glm::vec3(header.cameraPosition[0], header.cameraPosition[1], header.cameraPosition[2]);
+    state.cameraFront = glm::vec3(header.cameraFront[0], header.cameraFront[1], header.cameraFront[2]);
+
+    auto meshes = std::make_shared<DeformedPositions>(header.meshCount);
+    size_t countCursor = sizeof(SpillHeader);
+    size_t cursor = sizeof(SpillHeader) + alignUp(header.meshCount * sizeof(uint32_t));
+    for (auto& positions : *meshes) {
+        uint32_t count;
+        std::memcpy(&count, in + countCursor, sizeof(count));
+        countCursor += sizeof(count);
+        positions.resize(count);
+        std::memcpy(positions.data(), in + cursor, count * sizeof(glm::vec3));
+        cursor += count * sizeof(glm::vec3);
+    }
+    state.deformedPositions = meshes;
+    return true;
+}
+
+void FrameCache::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    memoryBudget = bytes;
+    evictLocked();
+}
+
+size_t FrameCache::getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memoryBudget;
+}
+
+void FrameCache::setTimeQuantum(float seconds) {
+    if (seconds <= 0.0f) return;
+    timeQuantum = seconds;
+    clear(); // Entries of the old quantum would be looked up at the wrong times
+}
+
+bool FrameCache::isSpillEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return spillFile.isOpen();
+}
+
+FrameCache::Stats FrameCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return { residentBytes, entries.size(), spillIndex.size(), hits, misses };
+}
+
+bool FrameCache::enableSpill(const std::string& path, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    spillRecords.clear();
+    spillIndex.clear();
+    spillHead = 0;
+    if (!spillFile.createReadWrite(path, capacity)) {
+        std::cerr << "Failed to create frame cache spill file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void FrameCache::disableSpill() {
+    std::lock_guard<std::mutex> lock(mutex);
+    spillFile.close();
+    spillRecords.clear();
+    spillIndex.clear();
+    spillHead = 0;
+}
+
+void FrameCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    entries.clear();
+    residentBytes = 0;
+    spillRecords.clear();
+    spillIndex.clear();
+    spillHead = 0;
+    hits = 0;
+    misses = 0;
+}
@@ -0,0 +1,101 @@
+#include "../Headers/GLStats.h"
+
+#include <glad/glad.h>
+
+namespace {
+    GLCounters counters;
+    bool installed = false;
+
+    PFNGLDRAWARRAYSPROC realDrawArrays = nullptr;
+    PFNGLDRAWELEMENTSPROC realDrawElements = nullptr;
+    PFNGLDRAWARRAYSINSTANCEDPROC realDrawArraysInstanced = nullptr;
+    PFNGLDRAWELEMENTSINSTANCEDPROC realDrawElementsInstanced = nullptr;
+    PFNGLBUFFERDATAPROC realBufferData = nullptr;
+    PFNGLBUFFERSUBDATAPROC realBufferSubData = nullptr;
+    PFNGLTEXIMAGE2DPROC realTexImage2D = nullptr;
+    PFNGLTEXSUBIMAGE2DPROC realTexSubImage2D = nullptr;
+
+    // Close enough for the formats this project uploads (8-bit channels, float for anything else)
+    uint64_t textureBytes(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+        uint64_t channels = (format == GL_RED) ? 1 : (format == GL_RG) ? 2 : (format == GL_RGB || format == GL_BGR) ? 3 : 4;
+        uint64_t channelBytes = (type == GL_UNSIGNED_BYTE) ? 1 : 4;
+        return static_cast<uint64_t>(width) * height * channels * channelBytes;
+    }
+
+    void APIENTRY countDrawArrays(GLenum mode, GLint first, GLsizei count) {
+        ++counters.drawCalls;
+        realDrawArrays(mode, first, count);
+    }
+
+    void APIENTRY countDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        ++counters.drawCalls;
+        realDrawElements(mode, count, type, indices);
+    }
+
+    void APIENTRY countDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+        ++counters.drawCalls;
+        realDrawArraysInstanced(mode, first, count, instances);
+    }
+
+    void APIENTRY countDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances) {
+        ++counters.drawCalls;
+        realDrawElementsInstanced(mode, count, type, indices, instances);
+    }
+
+    void APIENTRY countBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        if (data) counters.bufferUploadBytes += static_cast<uint64_t>(size);
+        realBufferData(target, size, data, usage);
+    }
+
+    void APIENTRY countBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        counters.bufferUploadBytes += static_cast<uint64_t>(size);
+        realBufferSubData(target, offset, size, data);
+    }
+
+    void APIENTRY countTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+        GLint border, GLenum format, GLenum type, const void* pixels) {
+        if (pixels) counters.textureUploadBytes += textureBytes(width, height, format, type);
+        realTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+    }
+
+    void APIENTRY countTexSubImage2D(GLenum target, GLint level, GLint xOffset, GLint yOffset, GLsizei width, GLsizei height,
+        GLenum format, GLenum type, const void* pixels) {
+        counters.textureUploadBytes += textureBytes(width, height, format, type);
+        realTexSubImage2D(target, level, xOffset, yOffset, width, height, format, type, pixels);
+    }
+}
+
+void GLStats::install() {
+    if (installed) return;
+    installed = true;
+
+    realDrawArrays = glad_glDrawArrays;
+    realDrawElements = glad_glDrawElements;
+    realDrawArraysInstanced = glad_glDrawArraysInstanced;
+    realDrawElementsInstanced = glad_glDrawElementsInstanced;
+    realBufferData = glad_glBufferData;
+    realBufferSubData = glad_glBufferSubData;
+    realTexImage2D = glad_glTexImage2D;
+    realTexSubImage2D = glad_glTexSubImage2D;
+
+    glad_glDrawArrays = countDrawArrays;
+    glad_glDrawElements = countDrawElements;
+    glad_glDrawArraysInstanced = countDrawArraysInstanced;
+    glad_glDrawElementsInstanced = countDrawElementsInstanced;
+    glad_glBufferData = countBufferData;
+    glad_glBufferSubData = countBufferSubData;
+    glad_glTexImage2D = countTexImage2D;
+    glad_glTexSubImage2D = countTexSubImage2D;
+}
+
+bool GLStats::isInstalled() {
+    return installed;
+}
+
+void GLStats::reset() {
+    counters = GLCounters();
+}
+
+GLCounters GLStats::get() {
+    return counters;
+}
@@ -0,0 +1,120 @@
+#include "../Headers/HeadlessContext.h"
+
+#include <glad/glad.h>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <GLFW/glfw3.h>
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+#ifdef _WIN32
+
+void HeadlessContext::create() {
+    if (!glfwInit()) {
+        throw std::runtime_error("Failed to initialize GLFW");
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(16, 16, "Batch", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        throw std::runtime_error("Failed to create hidden GLFW window");
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    context = window;
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        throw std::runtime_error("Failed to initialize GLAD");
+    }
+}
+
+void HeadlessContext::destroy() {
+    if (context) {
+        glfwDestroyWindow(static_cast<GLFWwindow*>(context));
+        glfwTerminate();
+        context = nullptr;
+    }
+}
+
+#else
+
+void HeadlessContext::create() {
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+
+    // Prefer the surfaceless platform: needs neither X11/Wayland nor a DRM device
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        throw std::runtime_error("Failed to initialize EGL display");
+    }
+    display = eglDisplay;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL does not support desktop OpenGL");
+    }
+
+    // Rendering goes to an FBO, so any config with a GL renderable type will do
+    const EGLint configAttributes[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        throw std::runtime_error("No suitable EGL config");
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        throw std::runtime_error("Failed to create EGL OpenGL 3.3 core context");
+    }
+    context = eglContext;
+
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        throw std::runtime_error("Failed to make the EGL context current (EGL_KHR_surfaceless_context missing?)");
+    }
+
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        throw std::runtime_error("Failed to initialize GLAD");
+    }
+    std::cout << "Headless EGL " << major << "." << minor << ", renderer: " << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << std::endl;
+}
+
+void HeadlessContext::destroy() {
+    if (display) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context) {
+            eglDestroyContext(display, context);
+        }
+        eglTerminate(display);
+    }
+    display = nullptr;
+    context = nullptr;
+}
+
+#endif
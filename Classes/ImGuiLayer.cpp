@@ -4,15 +4,22 @@
 #include "../Headers/VirtualCameraChannel.h"
 #include "../Headers/StepAheadAnimationChannel.h"
 #include "../Headers/CharacterAnimationChannel.h"
-#include "../Headers/KeyFrame.h"
+#include "../Headers/Core/KeyFrame.h"
 #include "../Headers/Channel.h"
+#include "../Headers/SceneFile.h"
+#include "../Headers/FrameCache.h"
+#include "../Headers/Profiler.h"
+#include "../Headers/Trace.h"
 
+#include <algorithm>
 #include <iostream>
 
 // Globals
 std::shared_ptr<Channel> selectedChannel;
+ChannelHandle selectedChannelHandle = INVALID_CHANNEL_HANDLE;
 Animation animationGUI("GUI Animation");
 Animation* animationMAIN = nullptr;
+std::mutex* sceneMutex = nullptr;
 
 
 // Helper functions
@@ -46,6 +53,13 @@ std::string formatFloat(float value, int decimalPlaces) {
     return stream.str();
 }
 
+// selectedChannel may still be the committed channel the main animation plays; every change
+// goes through here first, which swaps in a private copy once after each commit
+std::shared_ptr<Channel> editSelectedChannel() {
+    selectedChannel = animationGUI.editChannel(selectedChannelHandle);
+    return selectedChannel;
+}
+
 // ImGui functions
 void setupImGui(GLFWwindow* window, Animation* aMAIN) {
     animationMAIN = aMAIN;
@@ -69,7 +83,7 @@ void renderBackgroundEditor() {
 
     if (ImGui::Button("Load Texture")) {
         if (selectedChannel && selectedChannel->getType() == BACKGROUND) {
-            std::dynamic_pointer_cast<BackgroundChannel>(selectedChannel)->loadTexture(texturePath);
+            std::static_pointer_cast<BackgroundChannel>(editSelectedChannel())->loadTexture(texturePath);
             std::fill(std::begin(texturePath), std::end(texturePath), 0);
         }
     }
@@ -80,11 +94,15 @@ void renderBackgroundEditor() {
     if (ImGui::Button("Load Skybox")) {
         if (selectedChannel && selectedChannel->getType() == BACKGROUND) {
             std::vector<std::string> faces = getCubemapFaces(skyboxPath);
-            std::dynamic_pointer_cast<BackgroundChannel>(selectedChannel)->loadSkybox(faces);
+            std::static_pointer_cast<BackgroundChannel>(editSelectedChannel())->loadSkybox(faces);
             std::fill(std::begin(skyboxPath), std::end(skyboxPath), 0);
         }
     }
 
+    const TextureCache& textureCache = TextureCache::getInstance();
+    ImGui::Text("Texture cache: %d textures, %.1f MB", static_cast<int>(textureCache.getTextureCount()),
+        textureCache.getResidentBytes() / (1024.0f * 1024.0f));
+
     if (ImGui::Button("Close Background Editor")) {
         ImGui::CloseCurrentPopup();
     }
@@ -101,7 +119,7 @@ void renderStepAheadEditor() {
 
     if (ImGui::Button("Import OBJ")) {
         if (selectedChannel && selectedChannel->getType() == STEP_AHEAD_ANIMATION) {
-            std::dynamic_pointer_cast<StepAheadAnimationChannel>(selectedChannel)->importObject(objFilePath);
+            std::static_pointer_cast<StepAheadAnimationChannel>(editSelectedChannel())->importObject(objFilePath);
             std::fill(std::begin(objFilePath), std::end(objFilePath), 0);
         }
     }
@@ -117,12 +135,37 @@ void renderStepAheadEditor() {
     if (ImGui::Button("Load Shader")) {
         if (selectedChannel && selectedChannel->getType() == STEP_AHEAD_ANIMATION)
         {
-            std::dynamic_pointer_cast<StepAheadAnimationChannel>(selectedChannel)->setupShader(vertexShaderPath, fragmentShaderPath);
+            std::static_pointer_cast<StepAheadAnimationChannel>(editSelectedChannel())->setupShader(vertexShaderPath, fragmentShaderPath);
             std::fill(std::begin(vertexShaderPath), std::end(vertexShaderPath), 0);
             std::fill(std::begin(fragmentShaderPath), std::end(fragmentShaderPath), 0);
         }   
     }
 
+    if (selectedChannel && selectedChannel->getType() == STEP_AHEAD_ANIMATION) {
+        auto stepAhead = std::static_pointer_cast<const StepAheadAnimationChannel>(selectedChannel);
+        auto editStepAhead = []() { return std::static_pointer_cast<StepAheadAnimationChannel>(editSelectedChannel()); };
+        int interpolation = static_cast<int>(stepAhead->getRotationInterpolation());
+        if (ImGui::Combo("Rotation", &interpolation, "Slerp\0Squad\0")) {
+            editStepAhead()->setRotationInterpolation(static_cast<RotationInterpolation>(interpolation));
+        }
+
+        bool compressed = stepAhead->isCompressedPlayback();
+        CompressionTolerance tolerance = stepAhead->getCompressionTolerance();
+        bool compressionChanged = ImGui::Checkbox("Compressed Playback", &compressed);
+        if (compressed) {
+            compressionChanged |= ImGui::InputFloat("Position Tolerance", &tolerance.position, 0.0f, 0.0f, "%.4f");
+            compressionChanged |= ImGui::InputFloat("Rotation Tolerance", &tolerance.rotation, 0.0f, 0.0f, "%.4f rad");
+            compressionChanged |= ImGui::InputFloat("Scale Tolerance", &tolerance.scale, 0.0f, 0.0f, "%.4f");
+            const CompressedTrack& track = stepAhead->getCompressedTrack();
+            size_t rawBytes = stepAhead->getKeyFrames().size() * sizeof(KeyFrame);
+            ImGui::Text("%zu keys, %zu bytes (%.1fx smaller)", track.getKeyCount(), track.getByteSize(),
+                track.getByteSize() > 0 ? static_cast<float>(rawBytes) / track.getByteSize() : 0.0f);
+        }
+        if (compressionChanged) {
+            editStepAhead()->setCompressedPlayback(compressed, tolerance);
+        }
+    }
+
     ImGui::Separator();
 
     static float timestamp = 0.0f;
@@ -145,7 +188,7 @@ void renderStepAheadEditor() {
 
     if (ImGui::Button("Set Frame Rate")) {
         if (selectedChannel) {
-            selectedChannel->setFrameRate(frameRate);
+            editSelectedChannel()->setFrameRate(frameRate);
         }
     }
 
@@ -158,7 +201,7 @@ void renderStepAheadEditor() {
             rotQuat,
             glm::vec3(scale[0], scale[1], scale[2]));
         if (selectedChannel) {
-            selectedChannel->addKeyFrame(newKeyFrame);
+            editSelectedChannel()->addKeyFrame(newKeyFrame);
             // Clear input fields
             timestamp = 0.0f;
             position[0] = position[1] = position[2] = 0.0f;
@@ -173,7 +216,7 @@ void renderStepAheadEditor() {
 
     if (ImGui::Button("Load KeyFrames")) {
         if (selectedChannel) {
-            selectedChannel->loadKeyFramesFromFile(keyFrameFilePath);
+            editSelectedChannel()->loadKeyFramesFromFile(keyFrameFilePath);
         }
     }
     
@@ -205,7 +248,7 @@ void renderStepAheadEditor() {
         }
 
         if (selectedKeyFrameIndex != -1) {
-            KeyFrame& kf = selectedChannel->getKeyFrames()[selectedKeyFrameIndex];
+            const KeyFrame& kf = selectedChannel->getKeyFrames()[selectedKeyFrameIndex];
 
             timestamp = kf.timestamp;
             position[0] = kf.position.x;
@@ -222,21 +265,21 @@ void renderStepAheadEditor() {
             if (ImGui::Button("Update Key-Frame")) {
                 glm::quat rotQuat = eulerToQuaternion(glm::radians(rotation[0]), glm::radians(rotation[1]), glm::radians(rotation[2]));
                 KeyFrame updatedKeyFrame(timestamp, glm::vec3(position[0], position[1], position[2]), rotQuat, glm::vec3(scale[0], scale[1], scale[2]));
-                selectedChannel->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
+                editSelectedChannel()->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
             }
 
             if (ImGui::Button("Remove Key-Frame")) {
-                selectedChannel->removeKeyFrame(selectedKeyFrameIndex);
+                editSelectedChannel()->removeKeyFrame(selectedKeyFrameIndex);
                 selectedKeyFrameIndex = -1; // Clear selection
             }
 
             if (ImGui::Button("Move Up") && selectedKeyFrameIndex > 0) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
                 --selectedKeyFrameIndex;
             }
 
             if (ImGui::Button("Move Down") && selectedKeyFrameIndex < selectedChannel->getKeyFrames().size() - 1) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
                 ++selectedKeyFrameIndex;
             }
 
@@ -263,7 +306,10 @@ void renderStepAheadEditor() {
 
             if (selectedControlPointIndex != -1) {
                 if (ImGui::Button("Remove Control Point")) {
-                    kf.ffdControlPoints.erase(kf.ffdControlPoints.begin() + selectedControlPointIndex);
+                    auto channel = editSelectedChannel();
+                    std::vector<FFDControlPoint>& controlPoints = channel->getKeyFrames()[selectedKeyFrameIndex].ffdControlPoints;
+                    controlPoints.erase(controlPoints.begin() + selectedControlPointIndex);
+                    channel->markChanged();
                     selectedControlPointIndex = -1; // Clear selection
                 }
             }
@@ -275,12 +321,15 @@ void renderStepAheadEditor() {
             ImGui::InputFloat("Weight", &ffdWeight);
 
             if (ImGui::Button("Add Control Point")) {
-                kf.ffdControlPoints.emplace_back(
+                auto channel = editSelectedChannel();
+                std::vector<FFDControlPoint>& controlPoints = channel->getKeyFrames()[selectedKeyFrameIndex].ffdControlPoints;
+                controlPoints.emplace_back(
                     glm::vec3(ffdPosition[0], ffdPosition[1], ffdPosition[2]),
                     glm::vec3(ffdOriginalPosition[0], ffdOriginalPosition[1], ffdOriginalPosition[2]),
                     ffdWeight
                 );
-                selectedControlPointIndex = kf.ffdControlPoints.size() - 1; // Select the new control point
+                selectedControlPointIndex = controlPoints.size() - 1; // Select the new control point
+                channel->markChanged();
             }
         }
     }
@@ -313,7 +362,7 @@ void renderCharacterAnimationEditor() {
 
     if (ImGui::Button("Set Frame Rate")) {
         if (selectedChannel) {
-            selectedChannel->setFrameRate(frameRate);
+            editSelectedChannel()->setFrameRate(frameRate);
         }
     }
 
@@ -326,7 +375,7 @@ void renderCharacterAnimationEditor() {
             rotQuat,
             glm::vec3(scale[0], scale[1], scale[2]));
         if (selectedChannel) {
-            selectedChannel->addKeyFrame(newKeyFrame);
+            editSelectedChannel()->addKeyFrame(newKeyFrame);
             // Clear input fields
             timestamp = 0.0f;
             position[0] = position[1] = position[2] = 0.0f;
@@ -341,7 +390,7 @@ void renderCharacterAnimationEditor() {
 
     if (ImGui::Button("Load KeyFrames")) {
         if (selectedChannel) {
-            selectedChannel->loadKeyFramesFromFile(keyFrameFilePath);
+            editSelectedChannel()->loadKeyFramesFromFile(keyFrameFilePath);
         }
     }
 
@@ -373,7 +422,7 @@ void renderCharacterAnimationEditor() {
         }
 
         if (selectedKeyFrameIndex != -1) {
-            KeyFrame& kf = selectedChannel->getKeyFrames()[selectedKeyFrameIndex];
+            const KeyFrame& kf = selectedChannel->getKeyFrames()[selectedKeyFrameIndex];
 
             timestamp = kf.timestamp;
             position[0] = kf.position.x;
@@ -390,21 +439,21 @@ void renderCharacterAnimationEditor() {
             if (ImGui::Button("Update Key-Frame")) {
                 glm::quat rotQuat = eulerToQuaternion(glm::radians(rotation[0]), glm::radians(rotation[1]), glm::radians(rotation[2]));
                 KeyFrame updatedKeyFrame(timestamp, glm::vec3(position[0], position[1], position[2]), rotQuat, glm::vec3(scale[0], scale[1], scale[2]));
-                selectedChannel->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
+                editSelectedChannel()->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
             }
 
             if (ImGui::Button("Remove Key-Frame")) {
-                selectedChannel->removeKeyFrame(selectedKeyFrameIndex);
+                editSelectedChannel()->removeKeyFrame(selectedKeyFrameIndex);
                 selectedKeyFrameIndex = -1; // Clear selection
             }
 
             if (ImGui::Button("Move Up") && selectedKeyFrameIndex > 0) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
                 --selectedKeyFrameIndex;
             }
 
             if (ImGui::Button("Move Down") && selectedKeyFrameIndex < selectedChannel->getKeyFrames().size() - 1) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
                 ++selectedKeyFrameIndex;
             }
 
@@ -438,7 +487,7 @@ void renderKeyFrameEditor() {
     
     if (ImGui::Button("Set Frame Rate")) {
 		if (selectedChannel) {
-			selectedChannel->setFrameRate(frameRate);
+			editSelectedChannel()->setFrameRate(frameRate);
 		}
 	}
 
@@ -451,7 +500,7 @@ void renderKeyFrameEditor() {
             rotQuat,
             glm::vec3(scale[0], scale[1], scale[2]));
         if (selectedChannel) {
-            selectedChannel->addKeyFrame(newKeyFrame);
+            editSelectedChannel()->addKeyFrame(newKeyFrame);
             // Clear input fields
             timestamp = 0.0f;
             position[0] = position[1] = position[2] = 0.0f;
@@ -499,21 +548,21 @@ void renderKeyFrameEditor() {
             if (ImGui::Button("Update Key-Frame")) {
                 glm::quat rotQuat = eulerToQuaternion(glm::radians(rotation[0]), glm::radians(rotation[1]), glm::radians(rotation[2]));
                 KeyFrame updatedKeyFrame(timestamp, glm::vec3(position[0], position[1], position[2]), rotQuat, glm::vec3(scale[0], scale[1], scale[2]));
-                selectedChannel->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
+                editSelectedChannel()->updateKeyFrame(selectedKeyFrameIndex, updatedKeyFrame);
             }
 
             if (ImGui::Button("Remove Key-Frame")) {
-                selectedChannel->removeKeyFrame(selectedKeyFrameIndex);
+                editSelectedChannel()->removeKeyFrame(selectedKeyFrameIndex);
                 selectedKeyFrameIndex = -1; // Clear selection
             }
 
             if (ImGui::Button("Move Up") && selectedKeyFrameIndex > 0) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex - 1);
                 --selectedKeyFrameIndex;
             }
 
             if (ImGui::Button("Move Down") && selectedKeyFrameIndex < selectedChannel->getKeyFrames().size() - 1) {
-                selectedChannel->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
+                editSelectedChannel()->swapKeyFrames(selectedKeyFrameIndex, selectedKeyFrameIndex + 1);
                 ++selectedKeyFrameIndex;
             }
         }
@@ -522,6 +571,248 @@ void renderKeyFrameEditor() {
     ImGui::End();
 }
 
+std::shared_ptr<VirtualCameraChannel> editSelectedCamera() {
+    return std::static_pointer_cast<VirtualCameraChannel>(editSelectedChannel());
+}
+
+// Speed along the camera path; takes effect on the next Render Path
+void renderSpeedCurveEditor(const VirtualCameraChannel& camera) {
+    SpeedCurve curve = camera.getSpeedCurve();
+    bool changed = false;
+
+    int profile = static_cast<int>(curve.profile);
+    if (ImGui::Combo("Speed Profile", &profile, "Constant\0Ease In/Out\0Custom\0")) {
+        curve.profile = static_cast<SpeedProfile>(profile);
+        if (curve.profile == SpeedProfile::CUSTOM && curve.points.empty()) {
+            curve.points = { glm::vec2(0.25f, 0.25f), glm::vec2(0.5f, 0.5f), glm::vec2(0.75f, 0.75f) };
+        }
+        changed = true;
+    }
+
+    if (curve.profile == SpeedProfile::CUSTOM) {
+        // Distance covered at fixed time fractions; kept non-decreasing so the camera never reverses
+        for (size_t i = 0; i < curve.points.size(); ++i) {
+            float lower = (i > 0) ? curve.points[i - 1].y : 0.0f;
+            float upper = (i + 1 < curve.points.size()) ? curve.points[i + 1].y : 1.0f;
+            std::string label = "Distance at " + formatFloat(curve.points[i].x * 100.0f, 0) + "% time";
+            if (ImGui::SliderFloat(label.c_str(), &curve.points[i].y, lower, upper)) {
+                changed = true;
+            }
+        }
+    }
+
+    if (changed) {
+        editSelectedCamera()->setSpeedCurve(curve);
+    }
+    ImGui::Text("Path length: %.2f", camera.getPath().getLength());
+
+    const std::vector<glm::vec2>& speedProfile = camera.getSpeedProfile();
+    if (!speedProfile.empty()) {
+        std::vector<float> speeds;
+        float maxSpeed = 0.0f;
+        for (const glm::vec2& sample : speedProfile) {
+            speeds.push_back(sample.y);
+            maxSpeed = std::max(maxSpeed, sample.y);
+        }
+        std::string overlay = "max " + formatFloat(maxSpeed, 2) + " units/s";
+        ImGui::PlotLines("Speed", speeds.data(), static_cast<int>(speeds.size()), 0, overlay.c_str(), 0.0f, maxSpeed * 1.1f, ImVec2(0, 60));
+    }
+    int display = static_cast<int>(camera.getPathDisplay());
+    if (ImGui::Combo("Path Drawing", &display, "Spline On GPU\0Adaptive Tessellation\0")) {
+        editSelectedCamera()->setPathDisplay(static_cast<PathDisplay>(display));
+    }
+    if (camera.getPathDisplay() == PathDisplay::SPLINE_ON_GPU) {
+        int samples = camera.getSplineSampleCount();
+        if (ImGui::SliderInt("Path Samples", &samples, 16, 4096)) {
+            editSelectedCamera()->setSplineSampleCount(samples);
+        }
+    }
+    else {
+        // Path drawing detail; tighter bounds add vertices only where the path bends
+        PathTolerance tolerance = camera.getPathTolerance();
+        float angleDegrees = glm::degrees(tolerance.angle);
+        bool toleranceChanged = ImGui::SliderFloat("Chordal Error", &tolerance.chordal, 0.001f, 0.5f, "%.3f");
+        toleranceChanged |= ImGui::SliderFloat("Angular Error", &angleDegrees, 0.5f, 30.0f, "%.1f deg");
+        toleranceChanged |= ImGui::SliderFloat("Screen Error", &tolerance.pixels, 0.0f, 4.0f, tolerance.pixels > 0.0f ? "%.2f px" : "off");
+        if (toleranceChanged) {
+            tolerance.angle = glm::radians(angleDegrees);
+            editSelectedCamera()->setPathTolerance(tolerance);
+        }
+        ImGui::Text("Path vertices: %d", camera.getPathVertexCount());
+    }
+
+    bool inScene = camera.isSpeedCurveInScene();
+    if (ImGui::Checkbox("Speed Curve In Scene", &inScene)) {
+        editSelectedCamera()->setSpeedCurveInScene(inScene);
+    }
+}
+
+// What the camera looks at while following its path
+void renderCameraAimEditor(const VirtualCameraChannel& camera) {
+    int aim = static_cast<int>(camera.getAim());
+    if (ImGui::Combo("Aim", &aim, "Look At Point\0Keyframed Orientation\0Look At Channel\0")) {
+        editSelectedCamera()->setAim(static_cast<CameraAim>(aim));
+    }
+
+    if (camera.getAim() == CameraAim::LOOK_AT_POINT) {
+        glm::vec3 point = camera.getLookAtPoint();
+        if (ImGui::InputFloat3("Look At", &point.x)) {
+            editSelectedCamera()->setLookAtPoint(point);
+        }
+    }
+    else if (camera.getAim() == CameraAim::LOOK_AT_CHANNEL) {
+        std::shared_ptr<Channel> target = camera.getLookAtChannel();
+        if (ImGui::BeginCombo("Target", target ? target->getName().c_str() : "None")) {
+            if (ImGui::Selectable("None", !target)) {
+                editSelectedCamera()->setLookAtChannel(animationGUI, INVALID_CHANNEL_HANDLE);
+            }
+            for (const auto& channel : animationGUI.getChannels()) {
+                if (channel->getHandle() == camera.getHandle()) continue;
+                std::string label = channel->getName() + "##" + std::to_string(channel->getHandle());
+                if (ImGui::Selectable(label.c_str(), channel == target)) {
+                    editSelectedCamera()->setLookAtChannel(animationGUI, channel->getHandle());
+                }
+            }
+            ImGui::EndCombo();
+        }
+    }
+}
+
+// Global playback controls, acting on the animation that is being rendered
+void renderTransport() {
+    ImGui::Separator();
+    ImGui::Text("Timeline");
+
+    if (animationMAIN->isPlaying()) {
+        if (ImGui::Button("Pause")) animationMAIN->pause();
+    }
+    else if (ImGui::Button("Play")) {
+        if (animationMAIN->getPlaybackMode() == PlaybackMode::ONCE && animationMAIN->getPlayhead() >= animationMAIN->getDuration()) {
+            animationMAIN->seek(0.0f); // Replay from the start
+        }
+        animationMAIN->play();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Stop")) {
+        animationMAIN->pause();
+        animationMAIN->seek(0.0f);
+    }
+
+    // Scrubbing seeks every channel directly to the new time, however far it jumps
+    float playhead = animationMAIN->getPlayhead();
+    float duration = std::max(animationMAIN->getDuration(), 0.001f);
+    if (ImGui::SliderFloat("Time", &playhead, 0.0f, duration, "%.2f s")) {
+        animationMAIN->seek(playhead);
+    }
+
+    int mode = static_cast<int>(animationMAIN->getPlaybackMode());
+    if (ImGui::Combo("Playback", &mode, "Once\0Loop\0Ping-Pong\0")) {
+        animationMAIN->setPlaybackMode(static_cast<PlaybackMode>(mode));
+    }
+
+    float speed = animationMAIN->getPlaybackSpeed();
+    if (ImGui::SliderFloat("Speed", &speed, 0.1f, 4.0f, "%.2fx")) {
+        animationMAIN->setPlaybackSpeed(speed);
+    }
+
+    // Evaluated frames are reused across loop iterations
+    FrameCache& frameCache = FrameCache::getInstance();
+    bool cacheEnabled = frameCache.isEnabled();
+    if (ImGui::Checkbox("Frame Cache", &cacheEnabled)) {
+        frameCache.setEnabled(cacheEnabled);
+    }
+    int budgetMB = static_cast<int>(frameCache.getMemoryBudget() / (1024 * 1024));
+    if (ImGui::SliderInt("Cache Budget (MB)", &budgetMB, 16, 4096)) {
+        frameCache.setMemoryBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+    }
+    static char spillPath[256] = "framecache.spill";
+    static int spillMB = 1024;
+    bool spill = frameCache.isSpillEnabled();
+    ImGui::InputText("Spill File", spillPath, IM_ARRAYSIZE(spillPath));
+    ImGui::SliderInt("Spill Size (MB)", &spillMB, 64, 16384);
+    if (ImGui::Checkbox("Spill To Disk", &spill)) {
+        if (spill) frameCache.enableSpill(spillPath, static_cast<size_t>(spillMB) * 1024 * 1024);
+        else frameCache.disableSpill();
+    }
+    FrameCache::Stats stats = frameCache.getStats();
+    ImGui::Text("%d frames, %.1f MB, %d spilled, %llu hits / %llu misses", static_cast<int>(stats.entryCount),
+        stats.residentBytes / (1024.0f * 1024.0f), static_cast<int>(stats.spilledCount),
+        static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses));
+    if (ImGui::Button("Clear Cache")) {
+        frameCache.clear();
+    }
+
+    bool profiling = Profiler::getInstance().isEnabled();
+    if (ImGui::Checkbox("Profiler", &profiling)) {
+        Profiler::getInstance().setEnabled(profiling);
+    }
+    ImGui::Separator();
+}
+
+// Frame times plus per-channel CPU/GPU times of the last complete frame
+void renderProfilerOverlay() {
+    Profiler& profiler = Profiler::getInstance();
+    std::vector<ProfiledFrame> frames = profiler.getFrames();
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.8f);
+    ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing);
+    if (frames.empty()) {
+        ImGui::Text("Collecting...");
+        ImGui::End();
+        return;
+    }
+
+    std::vector<float> frameMs(frames.size());
+    float worstMs = 0.0f;
+    float totalMs = 0.0f;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frameMs[i] = static_cast<float>(frames[i].frameUs / 1000.0);
+        worstMs = std::max(worstMs, frameMs[i]);
+        totalMs += frameMs[i];
+    }
+    float averageMs = totalMs / frameMs.size();
+    ImGui::Text("Frame %.2f ms avg, %.2f ms worst (%d frames)", averageMs, worstMs, static_cast<int>(frames.size()));
+    ImGui::PlotLines("##FrameTimes", frameMs.data(), static_cast<int>(frameMs.size()), 0, "Frame time", 0.0f, worstMs * 1.1f, ImVec2(320.0f, 60.0f));
+
+    // Histogram of frame times in 1 ms buckets
+    const int bucketCount = 34;
+    std::vector<float> buckets(bucketCount, 0.0f);
+    for (float ms : frameMs) {
+        buckets[std::min(static_cast<int>(ms), bucketCount - 1)] += 1.0f;
+    }
+    ImGui::PlotHistogram("##FrameHistogram", buckets.data(), bucketCount, 0, "0-33+ ms", 0.0f, FLT_MAX, ImVec2(320.0f, 60.0f));
+
+    // Per-channel bars, as a share of the frame; GPU times lag a frame or two behind
+    const ProfiledFrame* latest = &frames.back();
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+        bool gpuResolved = std::any_of(it->channels.begin(), it->channels.end(),
+            [](const ChannelTiming& timing) { return timing.gpuUs >= 0.0; });
+        if (gpuResolved) {
+            latest = &*it;
+            break;
+        }
+    }
+    double frameUs = std::max(latest->frameUs, 1.0);
+    ImGui::Text("Frame %llu", static_cast<unsigned long long>(latest->frameIndex));
+    for (const ChannelTiming& timing : latest->channels) {
+        ImGui::Text("%s", timing.name.c_str());
+        std::string cpuLabel = "CPU " + formatFloat(static_cast<float>((timing.updateUs + timing.renderCpuUs) / 1000.0), 3) + " ms";
+        ImGui::ProgressBar(static_cast<float>((timing.updateUs + timing.renderCpuUs) / frameUs), ImVec2(320.0f, 0.0f), cpuLabel.c_str());
+        std::string gpuLabel = (timing.gpuUs >= 0.0) ? "GPU " + formatFloat(static_cast<float>(timing.gpuUs / 1000.0), 3) + " ms" : "GPU pending";
+        ImGui::ProgressBar(static_cast<float>(std::max(timing.gpuUs, 0.0) / frameUs), ImVec2(320.0f, 0.0f), gpuLabel.c_str());
+    }
+
+    static char tracePath[256] = "trace.json";
+    ImGui::InputText("Trace File", tracePath, IM_ARRAYSIZE(tracePath));
+    if (ImGui::Button("Export Chrome Trace")) {
+        if (profiler.exportChromeTrace(tracePath)) {
+            std::cout << "Wrote trace to " << tracePath << std::endl;
+        }
+    }
+    ImGui::End();
+}
+
 void renderChannelManager() {
     ImGui::Begin("Channel Manager");
 
@@ -547,34 +838,66 @@ void renderChannelManager() {
         std::fill(std::begin(channelName), std::end(channelName), 0);
     }
 
-    // Button to trigger the rendering of channels
+    // Button to trigger the rendering of channels: hands the channels edited since the last
+    // commit to the main animation, which swaps them in before its next update
     if (ImGui::Button("Render Channels")) {
-        *animationMAIN = animationGUI; // Copy the GUI animation to the main animation
+        animationMAIN->publish(animationGUI.commit());
+        animationMAIN->seek(0.0f);
+        animationMAIN->play();
+    }
+
+    renderTransport();
+
+    // Scene files, also the input of the headless --batch renderer
+    static char scenePath[256] = "scene.txt";
+    ImGui::InputText("Scene File", scenePath, IM_ARRAYSIZE(scenePath));
+    if (ImGui::Button("Save Scene")) {
+        saveScene(animationGUI, scenePath);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Load Scene")) {
+        if (loadScene(animationGUI, scenePath)) {
+            selectedChannel.reset();
+            animationMAIN->publish(animationGUI.commit(true));
+        }
+    }
+
+    bool parallelUpdate = animationGUI.isParallelUpdate();
+    if (ImGui::Checkbox("Parallel Channel Update", &parallelUpdate)) {
+        animationGUI.setParallelUpdate(parallelUpdate);
+        animationMAIN->setParallelUpdate(parallelUpdate);
+    }
+
+    float stepRate = animationGUI.getFixedStepRate();
+    if (ImGui::SliderFloat("Simulation Rate (Hz)", &stepRate, 10.0f, 240.0f, "%.0f")) {
+        animationGUI.setFixedStepRate(stepRate);
+        animationMAIN->setFixedStepRate(stepRate);
     }
 
     ImGui::Separator();
 
-    static int selectedChannelIndex = -1; // Index for the selected channel
+    // The selection is kept by handle, so it follows the channel through reordering and renames
+    // and is dropped when the channel is removed or another scene is loaded
     if (ImGui::BeginListBox("Channels")) {
-        for (int i = 0; i < animationGUI.getChannels().size(); ++i) {
-            bool isSelected = (selectedChannelIndex == i);
-            std::string channelDisplayName = animationGUI.getChannels()[i]->getName() + " (" + animationGUI.getChannels()[i]->getTypeString() + ")";
+        for (const auto& channel : animationGUI.getChannels()) {
+            bool isSelected = (channel->getHandle() == selectedChannelHandle);
+            std::string channelDisplayName = channel->getName() + " (" + channel->getTypeString() + ")##" + std::to_string(channel->getHandle());
             if (ImGui::Selectable(channelDisplayName.c_str(), isSelected)) {
-                selectedChannelIndex = i;
-                selectedChannel = animationGUI.getChannels()[i];
+                selectedChannelHandle = channel->getHandle();
             }
         }
         ImGui::EndListBox();
     }
+    // Read-only until an editor changes something, see editSelectedChannel()
+    selectedChannel = animationGUI.getChannel(selectedChannelHandle);
 
     // Buttons for moving channels up and down
-    if (selectedChannelIndex > 0 && ImGui::Button("Move Up")) {
+    size_t selectedChannelIndex = animationGUI.getChannelIndex(selectedChannelHandle);
+    if (selectedChannel && selectedChannelIndex > 0 && ImGui::Button("Move Up")) {
         animationGUI.swapChannels(selectedChannelIndex, selectedChannelIndex - 1);
-        --selectedChannelIndex;
     }
-    if (selectedChannelIndex < animationGUI.getChannels().size() - 1 && ImGui::Button("Move Down")) {
+    if (selectedChannel && selectedChannelIndex + 1 < animationGUI.getChannels().size() && ImGui::Button("Move Down")) {
         animationGUI.swapChannels(selectedChannelIndex, selectedChannelIndex + 1);
-        ++selectedChannelIndex;
     }
 
     if (selectedChannel) {
@@ -582,52 +905,96 @@ void renderChannelManager() {
         ImGui::InputText("New Channel Name##edit", newChannelName, IM_ARRAYSIZE(newChannelName));
 
         if (ImGui::Button("Change Channel Name")) {
-            animationGUI.updateChannelName(selectedChannel->getName(), newChannelName);
+            animationGUI.renameChannel(selectedChannelHandle, newChannelName);
             std::fill(std::begin(newChannelName), std::end(newChannelName), 0);
         }
 
         if (ImGui::Button("Remove Selected Channel")) {
-            animationGUI.removeChannel(selectedChannel->getName());
+            animationGUI.removeChannel(selectedChannelHandle);
             selectedChannel.reset();
-            selectedChannelIndex = -1; // Reset the selected index
+            selectedChannelHandle = INVALID_CHANNEL_HANDLE;
         }
 
         if (ImGui::Button("Edit Channel")) {
             if (selectedChannel->getType() == BACKGROUND) {
 				showBackgroundEditor = true;
-                ImGui::OpenPopup(("Background Channel Editor##" + std::to_string(selectedChannelIndex)).c_str());
+                ImGui::OpenPopup(("Background Channel Editor##" + std::to_string(selectedChannelHandle)).c_str());
 			}
             else if (selectedChannel->getType() == STEP_AHEAD_ANIMATION) {
 				showStepAheadEditor = true;
-				ImGui::OpenPopup(("Step Ahead Editor##" + std::to_string(selectedChannelIndex)).c_str());
+				ImGui::OpenPopup(("Step Ahead Editor##" + std::to_string(selectedChannelHandle)).c_str());
 			}
             else if (selectedChannel->getType() == CHARACTER_ANIMATION) {
 				showCharacterAnimationEditor = true;
-				ImGui::OpenPopup(("Character-Animation Editor##" + std::to_string(selectedChannelIndex)).c_str());
+				ImGui::OpenPopup(("Character-Animation Editor##" + std::to_string(selectedChannelHandle)).c_str());
 			}            
             else {
 				showKeyFrameEditor = true;
-                ImGui::OpenPopup(("Key-Frame Editor##" + std::to_string(selectedChannelIndex)).c_str());
+                ImGui::OpenPopup(("Key-Frame Editor##" + std::to_string(selectedChannelHandle)).c_str());
 			}
         }
 
         if (selectedChannel) {
             if (selectedChannel->getType() == VIRTUAL_CAMERA) {
                 if (ImGui::Button("Render Path")) {
-                    std::dynamic_pointer_cast<VirtualCameraChannel>(selectedChannel)->startTraversal();
+                    // Traversal starts on the edited copy and reaches the playing scene as a commit;
+                    // the committed camera is never touched
+                    editSelectedCamera()->startTraversal();
+                    animationMAIN->publish(animationGUI.commit());
+                    animationMAIN->seek(0.0f); // Play the path from the start of the timeline
+                    animationMAIN->play();
                 }
+                renderSpeedCurveEditor(*std::static_pointer_cast<const VirtualCameraChannel>(selectedChannel));
+                renderCameraAimEditor(*std::static_pointer_cast<const VirtualCameraChannel>(selectedChannel));
             }
         }        
 
+        // Update ordering between channels
+        static ChannelHandle dependencyHandle = INVALID_CHANNEL_HANDLE;
+        std::shared_ptr<Channel> dependency = animationGUI.getChannel(dependencyHandle);
+        if (ImGui::BeginCombo("Update After", dependency ? dependency->getName().c_str() : "None")) {
+            for (const auto& channel : animationGUI.getChannels()) {
+                std::string label = channel->getName() + "##" + std::to_string(channel->getHandle());
+                if (ImGui::Selectable(label.c_str(), channel == dependency)) {
+                    dependencyHandle = channel->getHandle();
+                }
+            }
+            ImGui::EndCombo();
+        }
+        if (dependency) {
+            if (ImGui::Button("Add Dependency")) {
+                animationGUI.addDependency(selectedChannelHandle, dependencyHandle);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Remove Dependency")) {
+                animationGUI.removeDependency(selectedChannelHandle, dependencyHandle);
+            }
+        }
+        for (ChannelHandle handle : selectedChannel->getDependencies()) {
+            if (auto target = animationGUI.getChannel(handle)) {
+                ImGui::Text("Updates after: %s", target->getName().c_str());
+            }
+        }
+
+        // Placement on the timeline
+        float timeOffset = selectedChannel->getTimeOffset();
+        if (ImGui::InputFloat("Time Offset (s)", &timeOffset, 0.1f, 1.0f, "%.2f")) {
+            editSelectedChannel()->setTimeOffset(timeOffset);
+        }
+        float timeScale = selectedChannel->getTimeScale();
+        if (ImGui::InputFloat("Time Scale", &timeScale, 0.1f, 0.5f, "%.2f") && timeScale > 0.0f) {
+            editSelectedChannel()->setTimeScale(timeScale);
+        }
+
         if (ImGui::Button("Activate")) {
-            selectedChannel->isActive = true;
+            editSelectedChannel()->isActive = true;
         }
 
         if (ImGui::Button("Deactivate")) {
-            selectedChannel->isActive = false;
+            editSelectedChannel()->isActive = false;
         }
 
-        if (ImGui::BeginPopupModal(("Background Channel Editor##" + std::to_string(selectedChannelIndex)).c_str(), &showBackgroundEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (ImGui::BeginPopupModal(("Background Channel Editor##" + std::to_string(selectedChannelHandle)).c_str(), &showBackgroundEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
             renderBackgroundEditor();
             if (ImGui::Button("Close")) {
                 showBackgroundEditor = false;
@@ -636,7 +1003,7 @@ void renderChannelManager() {
             ImGui::EndPopup();
         }
 
-        if (ImGui::BeginPopupModal(("Step Ahead Editor##" + std::to_string(selectedChannelIndex)).c_str(), &showStepAheadEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (ImGui::BeginPopupModal(("Step Ahead Editor##" + std::to_string(selectedChannelHandle)).c_str(), &showStepAheadEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
 			renderStepAheadEditor();
 			if (ImGui::Button("Close")) {
                 showStepAheadEditor = false;
@@ -645,7 +1012,7 @@ void renderChannelManager() {
 			ImGui::EndPopup();
 		}
 
-        if (ImGui::BeginPopupModal(("Character-Animation Editor##" + std::to_string(selectedChannelIndex)).c_str(), &showCharacterAnimationEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (ImGui::BeginPopupModal(("Character-Animation Editor##" + std::to_string(selectedChannelHandle)).c_str(), &showCharacterAnimationEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
             renderCharacterAnimationEditor();
             if (ImGui::Button("Close")) {
 				showCharacterAnimationEditor = false;
@@ -654,7 +1021,7 @@ void renderChannelManager() {
             ImGui::EndPopup();
         }
 
-        if (ImGui::BeginPopupModal(("Key-Frame Editor##" + std::to_string(selectedChannelIndex)).c_str(), &showKeyFrameEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (ImGui::BeginPopupModal(("Key-Frame Editor##" + std::to_string(selectedChannelHandle)).c_str(), &showKeyFrameEditor, ImGuiWindowFlags_AlwaysAutoResize)) {
             renderKeyFrameEditor();
             if (ImGui::Button("Close")) {
                 showKeyFrameEditor = false;
@@ -668,16 +1035,33 @@ void renderChannelManager() {
 }
 
 void renderImGui() {
+    TRACE_SCOPE("renderImGui");
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
-    renderChannelManager();
+    // Edits go to private channel copies and reach the simulation thread as commits, but the
+    // transport acts on the playing animation and copies are made from its channels: keep it out meanwhile
+    if (sceneMutex) {
+        std::lock_guard<std::mutex> lock(*sceneMutex);
+        renderChannelManager();
+    }
+    else {
+        renderChannelManager();
+    }
+
+    if (Profiler::getInstance().isEnabled()) {
+        renderProfilerOverlay();
+    }
 
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
+void setSceneMutex(std::mutex* mutex) {
+    sceneMutex = mutex;
+}
+
 void cleanupImGui() {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -0,0 +1,144 @@
+#include "../Headers/ImageWriter.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    struct CrcTable {
+        uint32_t entries[256];
+        CrcTable() {
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                entries[n] = c;
+            }
+        }
+    };
+
+    uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+        static const CrcTable table; // Thread-safe initialisation, writers may run concurrently
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void writeChunk(std::ofstream& out, const char type[4], const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> header;
+        putBigEndian(header, static_cast<uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        uint32_t crc = crc32(0, header.data() + 4, 4);
+        crc = crc32(crc, data.data(), data.size());
+        std::vector<uint8_t> footer;
+        putBigEndian(footer, crc);
+
+        out.write(reinterpret_cast<const char*>(header.data()), header.size());
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        out.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+    }
+
+    bool writePNG(std::ofstream& out, const uint8_t* rgba, int width, int height) {
+        static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        out.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        std::vector<uint8_t> header;
+        putBigEndian(header, static_cast<uint32_t>(width));
+        putBigEndian(header, static_cast<uint32_t>(height));
+        header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bit, RGBA, deflate, adaptive filter, no interlace
+        writeChunk(out, "IHDR", header);
+
+        // Filter byte 0 per row, rows flipped to top-first
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> scanlines;
+        scanlines.reserve((rowBytes + 1) * height);
+        for (int y = height - 1; y >= 0; --y) {
+            scanlines.push_back(0);
+            const uint8_t* row = rgba + rowBytes * y;
+            scanlines.insert(scanlines.end(), row, row + rowBytes);
+        }
+
+        // zlib stream made of stored deflate blocks (max 65535 bytes each)
+        std::vector<uint8_t> zlib;
+        zlib.reserve(scanlines.size() + scanlines.size() / 65535 * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        uint32_t adlerA = 1, adlerB = 0;
+        size_t offset = 0;
+        do {
+            size_t blockSize = std::min<size_t>(65535, scanlines.size() - offset);
+            bool last = offset + blockSize == scanlines.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(blockSize));
+            zlib.push_back(static_cast<uint8_t>(blockSize >> 8));
+            zlib.push_back(static_cast<uint8_t>(~blockSize));
+            zlib.push_back(static_cast<uint8_t>(~blockSize >> 8));
+            for (size_t i = offset; i < offset + blockSize; ++i) {
+                adlerA = (adlerA + scanlines[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+            zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + blockSize);
+            offset += blockSize;
+        } while (offset < scanlines.size());
+        putBigEndian(zlib, (adlerB << 16) | adlerA);
+        writeChunk(out, "IDAT", zlib);
+
+        writeChunk(out, "IEND", {});
+        return true;
+    }
+
+    bool writePPM(std::ofstream& out, const uint8_t* rgba, int width, int height) {
+        out << "P6\n" << width << " " << height << "\n255\n";
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+        for (int y = height - 1; y >= 0; --y) {
+            const uint8_t* source = rgba + static_cast<size_t>(width) * 4 * y;
+            for (int x = 0; x < width; ++x) {
+                row[x * 3 + 0] = source[x * 4 + 0];
+                row[x * 3 + 1] = source[x * 4 + 1];
+                row[x * 3 + 2] = source[x * 4 + 2];
+            }
+            out.write(reinterpret_cast<const char*>(row.data()), row.size());
+        }
+        return true;
+    }
+
+    bool writeRaw(std::ofstream& out, const uint8_t* rgba, int width, int height) {
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (int y = height - 1; y >= 0; --y) {
+            out.write(reinterpret_cast<const char*>(rgba + rowBytes * y), rowBytes);
+        }
+        return true;
+    }
+}
+
+bool writeImage(const std::string& path, ImageFormat format, const uint8_t* rgba, int width, int height) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open image for writing: " << path << std::endl;
+        return false;
+    }
+
+    switch (format) {
+    case ImageFormat::PNG: writePNG(out, rgba, width, height); break;
+    case ImageFormat::PPM: writePPM(out, rgba, width, height); break;
+    case ImageFormat::RAW: writeRaw(out, rgba, width, height); break;
+    }
+
+    if (!out.good()) {
+        std::cerr << "Failed to write image: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
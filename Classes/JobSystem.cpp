@@ -0,0 +1,101 @@
+#include "../Headers/JobSystem.h"
+#include "../Headers/Trace.h"
+
+namespace {
+    // Index of the queue owned by the current thread (0 for non-worker threads)
+    thread_local size_t currentQueueIndex = 0;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+    return instance;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    queues.push_back(std::make_unique<WorkQueue>()); // Shared queue for non-worker threads
+    for (unsigned i = 0; i < workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::submit(Job job) {
+    WorkQueue& queue = *queues[currentQueueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++queuedJobs;
+    }
+    wakeUp.notify_one();
+}
+
+// Pop from our own queue (LIFO, cache-warm), otherwise steal from the others (FIFO)
+bool JobSystem::tryGetJob(size_t queueIndex, Job& job) {
+    {
+        WorkQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            --queuedJobs;
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkQueue& victim = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            --queuedJobs;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(size_t queueIndex) {
+    currentQueueIndex = queueIndex;
+    TRACE_THREAD_NAME("Job Worker");
+
+    while (true) {
+        Job job;
+        if (tryGetJob(queueIndex, job)) {
+            job();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || queuedJobs > 0; });
+        if (stopping) return;
+    }
+}
+
+void JobSystem::runUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        Job job;
+        if (tryGetJob(currentQueueIndex, job)) {
+            job();
+        }
+        else {
+            std::this_thread::yield(); // Remaining jobs are running on workers
+        }
+    }
+}
@@ -0,0 +1,485 @@
+#include "../Headers/ModelCache.h"
+#include "../Headers/FileKey.h"
+#include "../Headers/MappedFile.h"
+#include "../Headers/Trace.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Cooked mesh file layout (native endianness, written and read by the same build):
+//   CookedHeader
+//   dependency records (path, file key as length-prefixed strings) for the material libraries and textures
+//   per mesh: CookedMeshHeader, texture records (type, path as length-prefixed strings),
+//             padding to 8 bytes, Vertex[vertexCount], uint32_t[indexCount], padding to 8 bytes
+namespace {
+    const char cookedMagic[8] = { 'C', 'S', 'A', 'M', 'E', 'S', 'H', '1' };
+    const uint32_t cookedVersion = 2;
+
+    struct CookedHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t vertexSize;  // sizeof(Vertex), guards against a changed Vertex layout
+        uint64_t sourceHash;
+        uint32_t meshCount;
+        uint32_t dependencyCount;
+    };
+
+    struct CookedMeshHeader {
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t textureCount;
+        uint32_t reserved;
+    };
+
+    // FNV-1a over the source file contents
+    uint64_t hashBytes(const unsigned char* data, size_t size) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    size_t alignTo8(size_t offset) {
+        return (offset + 7) & ~static_cast<size_t>(7);
+    }
+
+    void writePadding(std::ofstream& out) {
+        static const char zeros[8] = {};
+        size_t offset = static_cast<size_t>(out.tellp());
+        out.write(zeros, alignTo8(offset) - offset);
+    }
+
+    void writeString(std::ofstream& out, const std::string& value) {
+        uint32_t length = static_cast<uint32_t>(value.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(value.data(), length);
+    }
+
+    bool readString(const MappedFile& file, size_t& offset, std::string& value) {
+        uint32_t length;
+        if (offset + sizeof(length) > file.size()) return false;
+        std::memcpy(&length, file.data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (offset + length > file.size()) return false;
+        value.assign(reinterpret_cast<const char*>(file.data() + offset), length);
+        offset += length;
+        return true;
+    }
+
+    // Material libraries named by the "mtllib" lines of an .obj; other formats have none
+    std::vector<std::string> findMaterialLibraries(const MappedFile& source, const std::string& directory) {
+        std::vector<std::string> libraries;
+        const char* text = reinterpret_cast<const char*>(source.data());
+        size_t size = source.size();
+        for (size_t lineStart = 0; lineStart < size;) {
+            size_t lineEnd = lineStart;
+            while (lineEnd < size && text[lineEnd] != '\n') ++lineEnd;
+
+            std::string line(text + lineStart, lineEnd - lineStart);
+            if (line.compare(0, 7, "mtllib ") == 0) {
+                size_t first = line.find_first_not_of(" \t", 7);
+                size_t last = line.find_last_not_of(" \t\r");
+                if (first != std::string::npos) {
+                    libraries.push_back(directory + "/" + line.substr(first, last - first + 1));
+                }
+            }
+            lineStart = lineEnd + 1;
+        }
+        return libraries;
+    }
+}
+
+ModelAsset::ModelAsset(const std::string& path) {
+    TRACE_SCOPE("ModelAsset::load");
+    MappedFile source;
+    if (!source.openReadOnly(path)) {
+        return; // Leaves the asset empty, reported by ModelCache::load
+    }
+    uint64_t sourceHash = hashBytes(source.data(), source.size());
+
+    std::string cookedPath = path + ".meshcache";
+    std::string directory = path.substr(0, path.find_last_of("/\\"));
+    std::vector<std::string> materialFiles = findMaterialLibraries(source, directory);
+    source.close();
+
+    if (!loadCooked(cookedPath, sourceHash, directory)) {
+        loadWithAssimp(path, cookedPath, sourceHash, directory, materialFiles);
+    }
+}
+
+// Both load paths take their textures from the TextureCache, so they sample the same way
+void ModelAsset::resolveTextures(std::vector<Texture>& textures, const std::string& directory) {
+    for (auto& texture : textures) {
+        std::shared_ptr<CachedTexture> cached = TextureCache::getInstance().loadTexture2D(directory + "/" + texture.path);
+        texture.id = cached ? cached->id : 0;
+        if (cached) {
+            cachedTextures.push_back(cached);
+        }
+    }
+}
+
+// Map a cooked file and upload its vertex/index arrays straight from the mapping
+bool ModelAsset::loadCooked(const std::string& cookedPath, uint64_t sourceHash, const std::string& directory) {
+    MappedFile file;
+    if (!file.openReadOnly(cookedPath) || file.size() < sizeof(CookedHeader)) {
+        return false;
+    }
+
+    CookedHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, cookedMagic, sizeof(cookedMagic)) != 0 || header.version != cookedVersion ||
+        header.vertexSize != sizeof(Vertex) || header.sourceHash != sourceHash) {
+        return false; // Stale or foreign cache, fall back to Assimp and overwrite it
+    }
+
+    std::vector<SharedMesh> loaded;
+    auto discard = [&]() {
+        for (auto& mesh : loaded) {
+            glDeleteBuffers(1, &mesh.vbo);
+            glDeleteBuffers(1, &mesh.ebo);
+        }
+        cachedTextures.clear();
+        return false;
+    };
+
+    // The source hash only covers the model file; its materials and textures are checked by file key
+    size_t offset = sizeof(CookedHeader);
+    for (uint32_t d = 0; d < header.dependencyCount; ++d) {
+        std::string dependencyPath, fileKey;
+        if (!readString(file, offset, dependencyPath) || !readString(file, offset, fileKey)) return false;
+        if (makeFileCacheKey(dependencyPath) != fileKey) return false;
+    }
+
+    for (uint32_t m = 0; m < header.meshCount; ++m) {
+        CookedMeshHeader meshHeader;
+        if (offset + sizeof(meshHeader) > file.size()) return discard();
+        std::memcpy(&meshHeader, file.data() + offset, sizeof(meshHeader));
+        offset += sizeof(meshHeader);
+
+        SharedMesh shared;
+        for (uint32_t t = 0; t < meshHeader.textureCount; ++t) {
+            Texture texture;
+            if (!readString(file, offset, texture.type) || !readString(file, offset, texture.path)) return discard();
+            shared.textures.push_back(texture);
+        }
+        resolveTextures(shared.textures, directory);
+
+        offset = alignTo8(offset);
+        size_t vertexBytes = static_cast<size_t>(meshHeader.vertexCount) * sizeof(Vertex);
+        size_t indexBytes = static_cast<size_t>(meshHeader.indexCount) * sizeof(uint32_t);
+        if (offset + vertexBytes + indexBytes > file.size()) return discard();
+
+        const unsigned char* vertexData = file.data() + offset;
+        const unsigned char* indexData = vertexData + vertexBytes;
+        offset = alignTo8(offset + vertexBytes + indexBytes);
+
+        shared.restPositions.resize(meshHeader.vertexCount);
+        for (uint32_t v = 0; v < meshHeader.vertexCount; ++v) {
+            std::memcpy(&shared.restPositions[v], vertexData + v * sizeof(Vertex) + offsetof(Vertex, Position), sizeof(glm::vec3));
+        }
+        shared.indexCount = static_cast<GLsizei>(meshHeader.indexCount);
+
+        glGenBuffers(1, &shared.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, shared.vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexBytes, vertexData, GL_STATIC_DRAW);
+        glGenBuffers(1, &shared.ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, shared.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexData, GL_STATIC_DRAW);
+
+        loaded.push_back(std::move(shared));
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    meshes = std::move(loaded);
+    return true;
+}
+
+void ModelAsset::loadWithAssimp(const std::string& path, const std::string& cookedPath, uint64_t sourceHash,
+    const std::string& directory, const std::vector<std::string>& materialFiles) {
+    // The learnopengl Model does the Assimp import and the GL upload; afterwards
+    // only its buffer handles are kept and its CPU-side vertex copies are dropped
+    Model model(path.c_str());
+
+    for (const auto& mesh : model.meshes) {
+        SharedMesh shared;
+
+        // Mesh keeps its VBO/EBO private, so read them back from its VAO
+        GLint vbo = 0, ebo = 0;
+        glBindVertexArray(mesh.VAO);
+        glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vbo);
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ebo);
+        glBindVertexArray(0);
+
+        shared.vbo = static_cast<GLuint>(vbo);
+        shared.ebo = static_cast<GLuint>(ebo);
+        shared.indexCount = static_cast<GLsizei>(mesh.indices.size());
+        shared.textures = mesh.textures;
+        resolveTextures(shared.textures, directory);
+
+        shared.restPositions.reserve(mesh.vertices.size());
+        for (const auto& vertex : mesh.vertices) {
+            shared.restPositions.push_back(vertex.Position);
+        }
+
+        vertexArrays.push_back(mesh.VAO);
+        meshes.push_back(std::move(shared));
+    }
+
+    // The cached copies replace the textures the Model uploaded itself
+    for (const auto& texture : model.textures_loaded) {
+        glDeleteTextures(1, &texture.id);
+    }
+
+    if (meshes.empty()) return;
+
+    std::vector<std::string> dependencies = materialFiles;
+    for (const auto& texture : model.textures_loaded) {
+        dependencies.push_back(directory + "/" + texture.path);
+    }
+
+    // Write the processed arrays so the next import can skip Assimp entirely
+    std::ofstream out(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Could not write mesh cache: " << cookedPath << std::endl;
+        return;
+    }
+
+    CookedHeader header = {};
+    std::memcpy(header.magic, cookedMagic, sizeof(cookedMagic));
+    header.version = cookedVersion;
+    header.vertexSize = sizeof(Vertex);
+    header.sourceHash = sourceHash;
+    header.meshCount = static_cast<uint32_t>(model.meshes.size());
+    header.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& dependency : dependencies) {
+        writeString(out, dependency);
+        writeString(out, makeFileCacheKey(dependency));
+    }
+
+    for (const auto& mesh : model.meshes) {
+        CookedMeshHeader meshHeader = {};
+        meshHeader.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        meshHeader.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        meshHeader.textureCount = static_cast<uint32_t>(mesh.textures.size());
+        out.write(reinterpret_cast<const char*>(&meshHeader), sizeof(meshHeader));
+
+        for (const auto& texture : mesh.textures) {
+            writeString(out, texture.type);
+            writeString(out, texture.path);
+        }
+
+        writePadding(out);
+        out.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size() * sizeof(Vertex));
+        out.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(unsigned int));
+        writePadding(out);
+    }
+
+    if (!out) {
+        // A truncated file would fail validation anyway, but do not leave it around
+        out.close();
+        std::remove(cookedPath.c_str());
+    }
+}
+
+ModelAsset::~ModelAsset() {
+    // Buffers are owned by the asset in both load paths; cached textures release themselves
+    for (auto& mesh : meshes) {
+        glDeleteBuffers(1, &mesh.vbo);
+        glDeleteBuffers(1, &mesh.ebo);
+    }
+    if (!vertexArrays.empty()) {
+        glDeleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+    }
+}
+
+size_t ModelAsset::getVertexCount() const {
+    size_t count = 0;
+    for (const auto& mesh : meshes) {
+        count += mesh.restPositions.size();
+    }
+    return count;
+}
+
+ModelInstance::ModelInstance(std::shared_ptr<const ModelAsset> asset)
+    : asset(std::move(asset)) {
+}
+
+ModelInstance::~ModelInstance() {
+    for (auto& binding : bindings) {
+        if (binding.vao != 0) {
+            glDeleteVertexArrays(1, &binding.vao);
+        }
+        if (binding.positionVBO != 0) {
+            glDeleteBuffers(1, &binding.positionVBO);
+        }
+    }
+}
+
+void ModelInstance::setDeformedPositions(std::shared_ptr<const DeformedPositions> positions) {
+    if (positions != deformedPositions) {
+        deformedPositions = std::move(positions);
+        deformationDirty = true;
+    }
+}
+
+// Each instance gets its own VAOs that point at the shared vertex/index buffers
+void ModelInstance::setupBindings() {
+    const auto& meshes = asset->getMeshes();
+    bindings.resize(meshes.size());
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        glGenVertexArrays(1, &bindings[i].vao);
+        glBindVertexArray(bindings[i].vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, meshes[i].vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshes[i].ebo);
+
+        // Same attribute layout as learnopengl's Mesh::setupMesh
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
+        glEnableVertexAttribArray(5);
+        glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, m_BoneIDs));
+        glEnableVertexAttribArray(6);
+        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Weights));
+
+        bindPositionAttribute(i, false);
+    }
+
+    glBindVertexArray(0);
+}
+
+// Point attribute 0 either at the shared rest pose or at this instance's deformed positions
+void ModelInstance::bindPositionAttribute(size_t meshIndex, bool deformed) {
+    MeshBinding& binding = bindings[meshIndex];
+    glBindVertexArray(binding.vao);
+    glEnableVertexAttribArray(0);
+
+    if (deformed) {
+        glBindBuffer(GL_ARRAY_BUFFER, binding.positionVBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    }
+    else {
+        glBindBuffer(GL_ARRAY_BUFFER, asset->getMeshes()[meshIndex].vbo);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+    }
+
+    binding.positionsFromDeformation = deformed;
+}
+
+void ModelInstance::Draw(Shader& shader) {
+    const auto& meshes = asset->getMeshes();
+    if (bindings.size() != meshes.size()) {
+        setupBindings();
+    }
+
+    // Upload this instance's deformation, if any, before drawing
+    if (deformationDirty) {
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            bool deformed = deformedPositions && i < deformedPositions->size() &&
+                (*deformedPositions)[i].size() == meshes[i].restPositions.size();
+            if (deformed) {
+                MeshBinding& binding = bindings[i];
+                const auto& positions = (*deformedPositions)[i];
+                size_t byteSize = positions.size() * sizeof(glm::vec3);
+                if (binding.positionVBO == 0) {
+                    glGenBuffers(1, &binding.positionVBO);
+                    glBindBuffer(GL_ARRAY_BUFFER, binding.positionVBO);
+                    glBufferData(GL_ARRAY_BUFFER, byteSize, positions.data(), GL_DYNAMIC_DRAW);
+                }
+                else {
+                    glBindBuffer(GL_ARRAY_BUFFER, binding.positionVBO);
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, byteSize, positions.data());
+                }
+            }
+            if (bindings[i].positionsFromDeformation != deformed) {
+                bindPositionAttribute(i, deformed);
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        deformationDirty = false;
+    }
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const SharedMesh& mesh = meshes[i];
+
+        // Bind appropriate textures, following learnopengl's Mesh::Draw naming convention
+        unsigned int diffuseNr = 1;
+        unsigned int specularNr = 1;
+        unsigned int normalNr = 1;
+        unsigned int heightNr = 1;
+        for (unsigned int t = 0; t < mesh.textures.size(); t++) {
+            glActiveTexture(GL_TEXTURE0 + t);
+            std::string number;
+            const std::string& name = mesh.textures[t].type;
+            if (name == "texture_diffuse")
+                number = std::to_string(diffuseNr++);
+            else if (name == "texture_specular")
+                number = std::to_string(specularNr++);
+            else if (name == "texture_normal")
+                number = std::to_string(normalNr++);
+            else if (name == "texture_height")
+                number = std::to_string(heightNr++);
+
+            glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), t);
+            glBindTexture(GL_TEXTURE_2D, mesh.textures[t].id);
+        }
+
+        glBindVertexArray(bindings[i].vao);
+        glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+    }
+
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+ModelCache& ModelCache::getInstance() {
+    // Never destroyed, for the same reason as TextureCache::getInstance
+    static ModelCache* instance = new ModelCache();
+    return *instance;
+}
+
+std::shared_ptr<const ModelAsset> ModelCache::load(const std::string& path) {
+    std::string key = makeFileCacheKey(path);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        if (auto cached = it->second.lock()) {
+            return cached;
+        }
+    }
+
+    ModelAsset* asset = new ModelAsset(path);
+    if (!asset->isLoaded()) {
+        std::cerr << "Failed to load model: " << path << std::endl;
+        delete asset;
+        return nullptr;
+    }
+
+    std::shared_ptr<const ModelAsset> shared(asset, [key](ModelAsset* a) {
+        ModelCache::getInstance().release(key, a);
+    });
+    entries[key] = shared;
+    return shared;
+}
+
+void ModelCache::release(const std::string& key, ModelAsset* asset) {
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.expired()) {
+        entries.erase(it);
+    }
+    delete asset;
+}
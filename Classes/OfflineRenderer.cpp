@@ -0,0 +1,183 @@
+#include "../Headers/OfflineRenderer.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+OfflineRenderer::OfflineRenderer(const OfflineRenderSettings& settings) : settings(settings) {
+    if (this->settings.readbackDepth < 1) this->settings.readbackDepth = 1;
+    if (this->settings.maxQueuedFrames < 1) this->settings.maxQueuedFrames = 1;
+    if (this->settings.writerThreads < 1) this->settings.writerThreads = 1;
+}
+
+OfflineRenderer::~OfflineRenderer() {
+    finish();
+
+    for (auto& readback : readbacks) {
+        if (readback.fence) glDeleteSync(readback.fence);
+        if (readback.pbo) glDeleteBuffers(1, &readback.pbo);
+    }
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+}
+
+bool OfflineRenderer::init() {
+    if (!isValidPattern(settings.outputPattern)) {
+        std::cerr << "OfflineRenderer: invalid output pattern " << settings.outputPattern << std::endl;
+        return false;
+    }
+    frameBytes = static_cast<size_t>(settings.width) * settings.height * 4;
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, settings.width, settings.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, settings.width, settings.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offline render framebuffer is incomplete" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return false;
+    }
+
+    readbacks.resize(settings.readbackDepth);
+    for (auto& readback : readbacks) {
+        glGenBuffers(1, &readback.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    for (int i = 0; i < settings.writerThreads; ++i) {
+        writers.emplace_back(&OfflineRenderer::writerLoop, this);
+    }
+    return true;
+}
+
+void OfflineRenderer::beginFrame() {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, settings.width, settings.height);
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void OfflineRenderer::endFrame() {
+    Readback& readback = readbacks[nextFrame % readbacks.size()];
+    if (readback.frameIndex >= 0) {
+        collect(readback); // Issued readbackDepth frames ago, normally finished by now
+    }
+
+    // Copies into the PBO on the GPU timeline; returns without waiting for the pixels
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glReadPixels(0, 0, settings.width, settings.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.frameIndex = nextFrame++;
+}
+
+void OfflineRenderer::collect(Readback& readback) {
+    while (glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+        // Keep waiting; a software rasterizer can take longer than a second per frame
+    }
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    EncodedFrame frame{ readback.frameIndex, std::vector<uint8_t>(frameBytes) };
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(frame.pixels.data(), mapped, frameBytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.frameIndex = -1;
+
+    if (!mapped) {
+        std::cerr << "Failed to map readback buffer for frame " << frame.frameIndex << std::endl;
+        ++framesFailed;
+        return;
+    }
+
+    // Back-pressure: rendering waits when the disk cannot keep up
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this]() { return queue.size() < settings.maxQueuedFrames; });
+    queue.push_back(std::move(frame));
+    queueChanged.notify_all();
+}
+
+void OfflineRenderer::finish() {
+    // Oldest first, so frames reach the writers in order
+    for (size_t i = 0; i < readbacks.size(); ++i) {
+        Readback& readback = readbacks[(nextFrame + i) % readbacks.size()];
+        if (readback.frameIndex >= 0) {
+            collect(readback);
+        }
+    }
+    if (framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    writers.clear();
+}
+
+void OfflineRenderer::writerLoop() {
+    while (true) {
+        EncodedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return; // Stopping and drained
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+        queueChanged.notify_all(); // Room for the renderer again
+
+        if (writeImage(framePath(frame.frameIndex), settings.format, frame.pixels.data(), settings.width, settings.height)) {
+            ++framesWritten;
+        }
+        else {
+            ++framesFailed;
+        }
+    }
+}
+
+bool OfflineRenderer::isValidPattern(const std::string& pattern) {
+    int frameConversions = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] != '%') continue;
+        if (++i < pattern.size() && pattern[i] == '%') continue; // Literal percent sign
+
+        while (i < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i]))) ++i; // Zero pad and width
+        if (i >= pattern.size() || pattern[i] != 'd') return false;
+        ++frameConversions;
+    }
+    return frameConversions == 1;
+}
+
+std::string OfflineRenderer::framePath(int frameIndex) const {
+    char buffer[1024];
+    std::snprintf(buffer, sizeof(buffer), settings.outputPattern.c_str(), frameIndex);
+    return buffer;
+}
@@ -0,0 +1,187 @@
+#include "../Headers/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+
+Profiler& Profiler::getInstance() {
+    // Never destroyed, like the other singletons: channel updates may still report during shutdown
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+Profiler::Profiler() : origin(std::chrono::steady_clock::now()), ring(frameCapacity) {}
+
+double Profiler::nowUs() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+int Profiler::threadSlot() {
+    static std::atomic<int> nextSlot{ 0 };
+    thread_local int slot = nextSlot++;
+    return slot;
+}
+
+ChannelTiming& Profiler::channelLocked(ProfiledFrame& frame, const std::string& name) {
+    for (auto& timing : frame.channels) {
+        if (timing.name == name) return timing;
+    }
+    frame.channels.emplace_back();
+    frame.channels.back().name = name;
+    return frame.channels.back();
+}
+
+void Profiler::beginFrame() {
+    if (!enabled) return;
+
+    // Reuse the query set issued two frames ago, after collecting its results
+    querySet = 1 - querySet;
+    resolveQueries(querySet);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ProfiledFrame& frame = ring[ringHead];
+    frame.frameIndex = frameCounter++;
+    frame.startUs = nowUs();
+    frame.frameUs = 0.0;
+    frame.channels.clear();
+    frameOpen = true;
+}
+
+void Profiler::endFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!frameOpen) return;
+
+    ring[ringHead].frameUs = nowUs() - ring[ringHead].startUs;
+    ringHead = (ringHead + 1) % frameCapacity;
+    ringCount = std::min(ringCount + 1, frameCapacity - 1); // The head slot is always the open frame
+    frameOpen = false;
+}
+
+void Profiler::recordUpdate(const std::string& channelName, double startUs, double endUs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!frameOpen) return;
+
+    ChannelTiming& timing = channelLocked(ring[ringHead], channelName);
+    timing.updateStartUs = startUs;
+    timing.updateUs += endUs - startUs; // Several fixed steps may run in one frame
+    timing.updateThread = threadSlot();
+}
+
+void Profiler::beginRender(const std::string& channelName) {
+    if (!enabled || queryActive) return;
+
+    std::vector<GLuint>& pool = queryPool[querySet];
+    size_t used = pending[querySet].size();
+    if (used == pool.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        pool.push_back(query);
+    }
+    GLuint query = pool[used];
+
+    uint64_t frameIndex;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!frameOpen) return;
+        frameIndex = ring[ringHead].frameIndex;
+    }
+    pending[querySet].push_back({ query, frameIndex, channelName });
+
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    queryActive = true;
+    renderChannel = channelName;
+    renderStartUs = nowUs();
+}
+
+void Profiler::endRender() {
+    if (!queryActive) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    queryActive = false;
+
+    double endUs = nowUs();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!frameOpen) return;
+    ChannelTiming& timing = channelLocked(ring[ringHead], renderChannel);
+    timing.renderStartUs = renderStartUs;
+    timing.renderCpuUs = endUs - renderStartUs;
+}
+
+void Profiler::resolveQueries(int set) {
+    for (const PendingQuery& query : pending[set]) {
+        GLint available = 0;
+        glGetQueryObjectiv(query.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue; // Drop it rather than stall the pipeline
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(query.query, GL_QUERY_RESULT, &elapsedNs);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& frame : ring) {
+            if (frame.frameIndex != query.frameIndex) continue;
+            channelLocked(frame, query.channelName).gpuUs = elapsedNs / 1000.0;
+            break;
+        }
+    }
+    pending[set].clear();
+}
+
+std::vector<ProfiledFrame> Profiler::getFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<ProfiledFrame> frames;
+    frames.reserve(ringCount);
+    for (size_t i = ringCount; i > 0; --i) {
+        frames.push_back(ring[(ringHead + frameCapacity - i) % frameCapacity]);
+    }
+    return frames;
+}
+
+namespace {
+    std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(c) < 0x20) continue;
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    void writeEvent(std::ofstream& out, bool& first, const std::string& name, const char* category, double startUs, double durationUs, int thread) {
+        out << (first ? "" : ",\n") << "{\"name\":\"" << escapeJson(name) << "\",\"cat\":\"" << category
+            << "\",\"ph\":\"X\",\"ts\":" << startUs << ",\"dur\":" << durationUs << ",\"pid\":1,\"tid\":" << thread << "}";
+        first = false;
+    }
+}
+
+// Chrome trace event format (chrome://tracing, Perfetto). GPU times are durations only, so
+// GPU events are placed on their own track at the time their draw calls were issued.
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    const int gpuTrack = 1000;
+    out << std::fixed;
+    out.precision(3);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const ProfiledFrame& frame : getFrames()) {
+        writeEvent(out, first, "Frame " + std::to_string(frame.frameIndex), "frame", frame.startUs, frame.frameUs, 0);
+        for (const ChannelTiming& timing : frame.channels) {
+            if (timing.updateUs > 0.0) {
+                writeEvent(out, first, timing.name + " update", "update", timing.updateStartUs, timing.updateUs, 100 + timing.updateThread);
+            }
+            if (timing.renderCpuUs > 0.0) {
+                writeEvent(out, first, timing.name + " render", "render", timing.renderStartUs, timing.renderCpuUs, 0);
+            }
+            if (timing.gpuUs >= 0.0) {
+                writeEvent(out, first, timing.name + " GPU", "gpu", timing.renderStartUs, timing.gpuUs, gpuTrack);
+            }
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out.good();
+}
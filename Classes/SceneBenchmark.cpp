@@ -0,0 +1,362 @@
+#include "../Headers/SceneBenchmark.h"
+#include "../Headers/Animation.h"
+#include "../Headers/BackgroundChannel.h"
+#include "../Headers/Camera.h"
+#include "../Headers/CharacterAnimationChannel.h"
+#include "../Headers/GLStats.h"
+#include "../Headers/HeadlessContext.h"
+#include "../Headers/ImageWriter.h"
+#include "../Headers/StepAheadAnimationChannel.h"
+#include "../Headers/VirtualCameraChannel.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    struct SceneBenchSettings {
+        int backgrounds = 1;
+        int cameras = 1;
+        int ffdChannels = 4;
+        int characters = 2;
+        int keyFrames = 8;
+        int vertices = 10000;
+        int controlPoints = 8;
+        int frames = 240;
+        int warmupFrames = 10;
+        int width = 640;
+        int height = 480;
+        unsigned int seed = 1;
+        std::string assetDirectory = "scene_bench_assets";
+        std::string outputPath;
+    };
+
+    // std::mt19937's sequence is fixed by the standard, unlike the distributions, so scale it by hand
+    class SceneRandom {
+    public:
+        explicit SceneRandom(unsigned int seed) : engine(seed) {}
+        float next() { return (engine() >> 8) * (1.0f / 16777216.0f); }
+        float range(float low, float high) { return low + (high - low) * next(); }
+        glm::vec3 vec3(float extent) { return glm::vec3(range(-extent, extent), range(-extent, extent), range(-extent, extent)); }
+        glm::quat rotation() {
+            return glm::angleAxis(range(0.0f, 6.2831853f), glm::normalize(vec3(1.0f) + glm::vec3(0.0f, 0.0f, 0.001f)));
+        }
+
+    private:
+        std::mt19937 engine;
+    };
+
+    size_t peakResidentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.PeakWorkingSetSize;
+        }
+        return 0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss);        // Bytes on macOS
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024; // Kilobytes on Linux
+#endif
+#endif
+    }
+
+    void makeDirectory(const std::string& path) {
+#ifdef _WIN32
+        CreateDirectoryA(path.c_str(), nullptr);
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    // UV sphere with roughly vertexCount vertices, in OBJ so it goes through the normal import path
+    bool writeSphereObj(const std::string& path, int vertexCount) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write " << path << std::endl;
+            return false;
+        }
+
+        int rings = std::max(2, static_cast<int>(std::sqrt(vertexCount / 2.0f)));
+        int segments = std::max(3, vertexCount / (rings + 1) - 1);
+        const float pi = 3.14159265f;
+        for (int r = 0; r <= rings; ++r) {
+            float phi = pi * r / rings;
+            for (int s = 0; s <= segments; ++s) {
+                float theta = 2.0f * pi * s / segments;
+                glm::vec3 normal(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                out << "v " << normal.x << " " << normal.y << " " << normal.z << "\n";
+                out << "vn " << normal.x << " " << normal.y << " " << normal.z << "\n";
+                out << "vt " << static_cast<float>(s) / segments << " " << static_cast<float>(r) / rings << "\n";
+            }
+        }
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                int a = r * (segments + 1) + s + 1; // OBJ indices start at 1
+                int b = a + segments + 1;
+                out << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " " << (a + 1) << "/" << (a + 1) << "/" << (a + 1) << "\n";
+                out << "f " << (a + 1) << "/" << (a + 1) << "/" << (a + 1) << " " << b << "/" << b << "/" << b << " " << (b + 1) << "/" << (b + 1) << "/" << (b + 1) << "\n";
+            }
+        }
+        return out.good();
+    }
+
+    std::vector<std::string> writeSkyboxFaces(const std::string& directory) {
+        const int size = 128;
+        const char* names[6] = { "right", "left", "top", "bottom", "front", "back" };
+        std::vector<std::string> faces;
+        std::vector<uint8_t> pixels(size * size * 4);
+        for (int face = 0; face < 6; ++face) {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    uint8_t* pixel = &pixels[(y * size + x) * 4];
+                    pixel[0] = static_cast<uint8_t>(x * 2);
+                    pixel[1] = static_cast<uint8_t>(y * 2);
+                    pixel[2] = static_cast<uint8_t>(face * 40);
+                    pixel[3] = 255;
+                }
+            }
+            std::string path = directory + "/" + names[face] + ".png";
+            if (!writeImage(path, ImageFormat::PNG, pixels.data(), size, size)) {
+                return {};
+            }
+            faces.push_back(path);
+        }
+        return faces;
+    }
+
+    void addRandomKeyFrames(Channel& channel, int count, int controlPointCount, float extent, SceneRandom& random) {
+        std::vector<glm::vec3> restPoints;
+        for (int c = 0; c < controlPointCount; ++c) {
+            restPoints.push_back(random.vec3(1.0f));
+        }
+        for (int k = 0; k < count; ++k) {
+            KeyFrame keyFrame(static_cast<float>(k), random.vec3(extent), random.rotation(), glm::vec3(random.range(0.5f, 1.5f)));
+            for (const glm::vec3& rest : restPoints) {
+                keyFrame.ffdControlPoints.push_back(FFDControlPoint(rest + random.vec3(0.3f), rest, random.range(0.5f, 1.5f)));
+            }
+            channel.addKeyFrame(keyFrame);
+        }
+    }
+
+    bool buildScene(Animation& animation, const SceneBenchSettings& settings) {
+        SceneRandom random(settings.seed);
+        makeDirectory(settings.assetDirectory);
+
+        std::vector<std::string> faces;
+        if (settings.backgrounds > 0) {
+            faces = writeSkyboxFaces(settings.assetDirectory);
+            if (faces.empty()) return false;
+        }
+        std::string meshPath = settings.assetDirectory + "/sphere_" + std::to_string(settings.vertices) + ".obj";
+        if (settings.ffdChannels > 0 && !writeSphereObj(meshPath, settings.vertices)) {
+            return false;
+        }
+
+        for (int i = 0; i < settings.backgrounds; ++i) {
+            auto background = std::make_shared<BackgroundChannel>("Background " + std::to_string(i));
+            background->loadSkybox(faces);
+            animation.addChannel(background);
+        }
+        for (int i = 0; i < settings.cameras; ++i) {
+            auto camera = std::make_shared<VirtualCameraChannel>("Camera " + std::to_string(i));
+            addRandomKeyFrames(*camera, settings.keyFrames, 0, 8.0f, random);
+            camera->startTraversal();
+            animation.addChannel(camera);
+        }
+        for (int i = 0; i < settings.ffdChannels; ++i) {
+            auto channel = std::make_shared<StepAheadAnimationChannel>("FFD " + std::to_string(i));
+            channel->importObject(meshPath); // One shared asset, one deformation per channel
+            channel->setupShader("sphere.vs", "sphere.fs");
+            addRandomKeyFrames(*channel, settings.keyFrames, settings.controlPoints, 4.0f, random);
+            animation.addChannel(channel);
+        }
+        for (int i = 0; i < settings.characters; ++i) {
+            auto character = std::make_shared<CharacterAnimationChannel>("Character " + std::to_string(i));
+            addRandomKeyFrames(*character, settings.keyFrames, 0, 4.0f, random);
+            animation.addChannel(character);
+        }
+        return true;
+    }
+
+    double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t index = static_cast<size_t>(std::ceil(fraction * values.size())) - 1;
+        return values[std::min(index, values.size() - 1)];
+    }
+}
+
+int runSceneBenchmark(int argc, char** argv) {
+    SceneBenchSettings settings;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--channels" && hasValue) {
+            int count = std::atoi(argv[++i]);
+            settings.backgrounds = settings.cameras = settings.ffdChannels = settings.characters = count;
+        }
+        else if (arg == "--backgrounds" && hasValue) settings.backgrounds = std::atoi(argv[++i]);
+        else if (arg == "--cameras" && hasValue) settings.cameras = std::atoi(argv[++i]);
+        else if (arg == "--ffd" && hasValue) settings.ffdChannels = std::atoi(argv[++i]);
+        else if (arg == "--characters" && hasValue) settings.characters = std::atoi(argv[++i]);
+        else if (arg == "--keyframes" && hasValue) settings.keyFrames = std::max(2, std::atoi(argv[++i]));
+        else if (arg == "--vertices" && hasValue) settings.vertices = std::max(16, std::atoi(argv[++i]));
+        else if (arg == "--control-points" && hasValue) settings.controlPoints = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--frames" && hasValue) settings.frames = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--warmup" && hasValue) settings.warmupFrames = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--size" && hasValue) std::sscanf(argv[++i], "%dx%d", &settings.width, &settings.height);
+        else if (arg == "--seed" && hasValue) settings.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--assets" && hasValue) settings.assetDirectory = argv[++i];
+        else if (arg == "--bench-out" && hasValue) settings.outputPath = argv[++i];
+    }
+    if (settings.width <= 0 || settings.height <= 0) {
+        std::cerr << "Invalid --size" << std::endl;
+        return -1;
+    }
+
+    HeadlessContext context;
+    try {
+        context.create();
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    GLStats::install();
+
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    std::string rendererName = renderer ? renderer : "unknown";
+
+    std::vector<double> frameMs;
+    GLCounters totals;
+    GLCounters setupCounters;
+    double totalSeconds = 0.0;
+    {
+        // Scoped so every GL object is released while the context still exists
+        Animation animation("Scene Benchmark");
+        auto setupStart = std::chrono::steady_clock::now();
+        if (!buildScene(animation, settings)) {
+            return -1;
+        }
+        setupCounters = GLStats::get();
+        double setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+        std::cout << "Scene built in " << setupSeconds << " s on " << rendererName << std::endl;
+
+        GLuint framebuffer, colorBuffer, depthBuffer;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glGenRenderbuffers(1, &colorBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, settings.width, settings.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, settings.width, settings.height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+        glViewport(0, 0, settings.width, settings.height);
+        glEnable(GL_DEPTH_TEST);
+
+        Camera& camera = Camera::getInstance();
+        float step = animation.getFixedStep();
+        float aspect = static_cast<float>(settings.width) / settings.height;
+        FrameSnapshot snapshot;
+
+        for (int frame = 0; frame < settings.warmupFrames + settings.frames; ++frame) {
+            GLStats::reset();
+            auto start = std::chrono::steady_clock::now();
+
+            animation.advanceExact(step); // Simulated time must not depend on the frame rate measured
+            animation.captureInterpolated(snapshot);
+            animation.applyCamera(snapshot);
+
+            glm::mat4 view = camera.GetViewMatrix();
+            glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), aspect, 0.1f, 100.0f);
+            animation.setSkyboxView(glm::mat4(glm::mat3(view)));
+
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            animation.renderSnapshot(snapshot, view, projection);
+            glFinish(); // A software rasterizer only does the work here; count it in the frame
+
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (frame < settings.warmupFrames) continue;
+
+            frameMs.push_back(elapsed * 1000.0);
+            totalSeconds += elapsed;
+            GLCounters counters = GLStats::get();
+            totals.drawCalls += counters.drawCalls;
+            totals.bufferUploadBytes += counters.bufferUploadBytes;
+            totals.textureUploadBytes += counters.textureUploadBytes;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteFramebuffers(1, &framebuffer);
+    }
+
+    double frames = static_cast<double>(frameMs.size());
+    double fps = totalSeconds > 0.0 ? frames / totalSeconds : 0.0;
+    double p50 = percentile(frameMs, 0.50);
+    double p99 = percentile(frameMs, 0.99);
+    double drawCallsPerFrame = totals.drawCalls / frames;
+    double uploadBytesPerFrame = (totals.bufferUploadBytes + totals.textureUploadBytes) / frames;
+    double peakRssMB = peakResidentBytes() / (1024.0 * 1024.0);
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "Frames:            " << static_cast<int>(frames) << " (+" << settings.warmupFrames << " warm-up)\n"
+        << "Frames/s:          " << fps << "\n"
+        << "Frame time p50:    " << p50 << " ms\n"
+        << "Frame time p99:    " << p99 << " ms\n"
+        << "Draw calls/frame:  " << drawCallsPerFrame << "\n"
+        << "Upload bytes/frame:" << std::setw(12) << uploadBytesPerFrame << "\n"
+        << "Setup uploads:     " << (setupCounters.bufferUploadBytes + setupCounters.textureUploadBytes) / (1024.0 * 1024.0) << " MB\n"
+        << "Peak RSS:          " << peakRssMB << " MB" << std::endl;
+
+    if (settings.outputPath.empty()) {
+        return 0;
+    }
+    std::ofstream out(settings.outputPath, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open benchmark output: " << settings.outputPath << std::endl;
+        return -1;
+    }
+    out << std::fixed << std::setprecision(3)
+        << "{\n  \"scene\": {\"backgrounds\": " << settings.backgrounds << ", \"cameras\": " << settings.cameras
+        << ", \"ffd\": " << settings.ffdChannels << ", \"characters\": " << settings.characters
+        << ", \"keyframes\": " << settings.keyFrames << ", \"vertices\": " << settings.vertices
+        << ", \"control_points\": " << settings.controlPoints << ", \"width\": " << settings.width
+        << ", \"height\": " << settings.height << ", \"seed\": " << settings.seed << "},\n"
+        << "  \"renderer\": \"" << rendererName << "\",\n"
+        << "  \"frames\": " << static_cast<int>(frames) << ",\n"
+        << "  \"fps\": " << fps << ",\n"
+        << "  \"frame_ms_p50\": " << p50 << ",\n"
+        << "  \"frame_ms_p99\": " << p99 << ",\n"
+        << "  \"draw_calls_per_frame\": " << drawCallsPerFrame << ",\n"
+        << "  \"buffer_upload_bytes_per_frame\": " << totals.bufferUploadBytes / frames << ",\n"
+        << "  \"texture_upload_bytes_per_frame\": " << totals.textureUploadBytes / frames << ",\n"
+        << "  \"setup_upload_bytes\": " << (setupCounters.bufferUploadBytes + setupCounters.textureUploadBytes) << ",\n"
+        << "  \"peak_rss_bytes\": " << peakResidentBytes() << "\n}\n";
+    return out.good() ? 0 : -1;
+}
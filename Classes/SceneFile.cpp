@@ -0,0 +1,192 @@
+#include "../Headers/SceneFile.h"
+#include "../Headers/BackgroundChannel.h"
+#include "../Headers/VirtualCameraChannel.h"
+#include "../Headers/StepAheadAnimationChannel.h"
+#include "../Headers/CharacterAnimationChannel.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Splits "Key: value" into its parts; false if the line has no ": "
+    bool splitKeyValue(const std::string& line, std::string& key, std::string& value) {
+        size_t separator = line.find(": ");
+        if (separator == std::string::npos) return false;
+        key = line.substr(0, separator);
+        value = line.substr(separator + 2);
+        return true;
+    }
+
+    void trimLine(std::string& line) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.pop_back();
+        }
+        size_t start = line.find_first_not_of(" \t");
+        line.erase(0, start == std::string::npos ? line.size() : start);
+    }
+}
+
+std::shared_ptr<Channel> createChannel(ChannelType type, const std::string& name) {
+    switch (type) {
+    case BACKGROUND: return std::make_shared<BackgroundChannel>(name);
+    case VIRTUAL_CAMERA: return std::make_shared<VirtualCameraChannel>(name);
+    case STEP_AHEAD_ANIMATION: return std::make_shared<StepAheadAnimationChannel>(name);
+    case CHARACTER_ANIMATION: return std::make_shared<CharacterAnimationChannel>(name);
+    default: return nullptr;
+    }
+}
+
+bool saveScene(const Animation& animation, const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open scene file for writing: " << path << std::endl;
+        return false;
+    }
+    out << std::setprecision(9); // Round-trips floats exactly
+
+    out << "Scene: " << animation.getName() << "\n";
+    out << "StepRate: " << animation.getFixedStepRate() << "\n";
+    for (const auto& channel : animation.getChannels()) {
+        out << "Channel: " << static_cast<int>(channel->getType()) << " " << channel->getName() << "\n";
+        out << "Active: " << (channel->isActive ? 1 : 0) << "\n";
+        out << "FrameRate: " << channel->getFrameRate() << "\n";
+        out << "TimeOffset: " << channel->getTimeOffset() << "\n";
+        out << "TimeScale: " << channel->getTimeScale() << "\n";
+        channel->writeSceneSettings(out);
+        channel->saveKeyFrames(out);
+        out << "EndChannel\n";
+    }
+    for (const auto& channel : animation.getChannels()) {
+        for (ChannelHandle dependency : channel->getDependencies()) {
+            if (auto target = animation.getChannel(dependency)) {
+                out << "Dependency: " << channel->getName() << " -> " << target->getName() << "\n";
+            }
+        }
+        if (channel->getType() == VIRTUAL_CAMERA) {
+            if (auto target = animation.getChannel(std::static_pointer_cast<VirtualCameraChannel>(channel)->getLookAtHandle())) {
+                out << "LookAt: " << channel->getName() << " -> " << target->getName() << "\n";
+            }
+        }
+    }
+
+    if (!out.good()) {
+        std::cerr << "Failed to write scene file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadScene(Animation& animation, const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open scene file: " << path << std::endl;
+        return false;
+    }
+
+    Animation loaded("Main Animation");
+    std::shared_ptr<Channel> current;
+    std::stringstream keyFrameLines;
+    std::vector<std::pair<std::string, std::string>> dependencies;
+    std::vector<std::pair<std::string, std::string>> lookAts;
+
+    std::string line, key, value;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        trimLine(line);
+        if (line.empty()) continue;
+
+        if (line == "EndChannel") {
+            if (current) {
+                current->loadKeyFrames(keyFrameLines);
+                loaded.addChannel(current);
+            }
+            current.reset();
+            keyFrameLines.str("");
+            keyFrameLines.clear();
+            continue;
+        }
+        if (!current) {
+            if (!splitKeyValue(line, key, value)) {
+                std::cerr << "Scene " << path << ":" << lineNumber << ": unexpected line: " << line << std::endl;
+                continue;
+            }
+            if (key == "Scene") {
+                loaded = Animation(value);
+            }
+            else if (key == "StepRate") {
+                loaded.setFixedStepRate(std::strtof(value.c_str(), nullptr));
+            }
+            else if (key == "Channel") {
+                std::istringstream header(value);
+                int type = -1;
+                std::string name;
+                header >> type;
+                std::getline(header >> std::ws, name);
+                current = createChannel(static_cast<ChannelType>(type), name);
+                if (!current) {
+                    std::cerr << "Scene " << path << ":" << lineNumber << ": unknown channel type " << type << std::endl;
+                    return false;
+                }
+            }
+            else if (key == "Dependency" || key == "LookAt") {
+                size_t arrow = value.find(" -> ");
+                if (arrow != std::string::npos) {
+                    (key == "Dependency" ? dependencies : lookAts).emplace_back(value.substr(0, arrow), value.substr(arrow + 4));
+                }
+            }
+            continue;
+        }
+
+        // Inside a channel block
+        if (line.compare(0, 4, "Set ") == 0 && splitKeyValue(line.substr(4), key, value)) {
+            current->readSceneSetting(key, value);
+        }
+        else if (splitKeyValue(line, key, value) && key == "Active") {
+            current->isActive = (value != "0");
+        }
+        else if (splitKeyValue(line, key, value) && key == "FrameRate") {
+            current->setFrameRate(std::strtof(value.c_str(), nullptr));
+        }
+        else if (splitKeyValue(line, key, value) && key == "TimeOffset") {
+            current->setTimeOffset(std::strtof(value.c_str(), nullptr));
+        }
+        else if (splitKeyValue(line, key, value) && key == "TimeScale") {
+            float scale = std::strtof(value.c_str(), nullptr);
+            current->setTimeScale(scale > 0.0f ? scale : 1.0f);
+        }
+        else {
+            keyFrameLines << line << "\n";
+        }
+    }
+
+    if (current) {
+        std::cerr << "Scene " << path << ": missing EndChannel for " << current->getName() << std::endl;
+        return false;
+    }
+
+    for (const auto& dependency : dependencies) {
+        auto channel = loaded.getChannel(dependency.first);
+        auto target = loaded.getChannel(dependency.second);
+        if (channel && target) {
+            loaded.addDependency(channel->getHandle(), target->getHandle());
+        }
+    }
+    for (const auto& lookAt : lookAts) {
+        auto camera = loaded.getChannel(lookAt.first);
+        auto target = loaded.getChannel(lookAt.second);
+        if (camera && target && camera->getType() == VIRTUAL_CAMERA) {
+            auto edited = std::static_pointer_cast<VirtualCameraChannel>(loaded.editChannel(camera->getHandle()));
+            edited->setLookAtChannel(loaded, target->getHandle()); // A refused cycle is reported by addDependency
+        }
+    }
+
+    loaded.setParallelUpdate(animation.isParallelUpdate());
+    animation = loaded;
+    return true;
+}
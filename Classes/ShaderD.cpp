@@ -57,6 +57,12 @@ ShaderD::ShaderD(const char* vertexPath, const char* fragmentPath) {
     compiled = success == GL_TRUE;
 }
 
+ShaderD::~ShaderD() {
+    if (ID != 0) {
+        glDeleteProgram(ID);
+    }
+}
+
 void ShaderD::use() {
     glUseProgram(ID);
 }
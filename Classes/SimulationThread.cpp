@@ -0,0 +1,78 @@
+#include "../Headers/SimulationThread.h"
+#include "../Headers/Trace.h"
+
+#include <chrono>
+
+SimulationThread::SimulationThread(Animation& animation) : animation(animation) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+    releaseRetiredChannels();
+}
+
+void SimulationThread::start() {
+    if (running.exchange(true)) return;
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    if (!running.exchange(false)) return;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+const FrameSnapshot& SimulationThread::latestSnapshot() {
+    snapshots.acquireLatest();
+    return snapshots.readBuffer();
+}
+
+void SimulationThread::releaseRetiredChannels() {
+    std::vector<std::shared_ptr<Channel>> released;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        released.swap(retiredChannels);
+    }
+    // The last references may go here, outside the lock
+}
+
+void SimulationThread::run() {
+    using clock = std::chrono::steady_clock;
+    auto nextStep = clock::now();
+    TRACE_THREAD_NAME("Simulation");
+
+    while (running.load()) {
+        FrameSnapshot& snapshot = snapshots.writeBuffer();
+
+        // Hand the channels of the recycled snapshot to the render thread instead of
+        // possibly releasing the last reference (and with it GL objects) here
+        if (!snapshot.channels.empty()) {
+            std::lock_guard<std::mutex> lock(retiredMutex);
+            retiredChannels.insert(retiredChannels.end(), snapshot.channels.begin(), snapshot.channels.end());
+            snapshot.channels.clear();
+        }
+
+        float stepSeconds;
+        std::vector<std::shared_ptr<Channel>> replaced;
+        {
+            std::lock_guard<std::mutex> lock(sceneMutex);
+            animation.applyPublished(replaced); // Scene edits committed by the GUI, between two steps
+            stepSeconds = animation.getFixedStep(); // The GUI may change the rate
+            animation.update(stepSeconds);
+            animation.captureSnapshot(snapshot);
+        }
+        snapshots.publish();
+
+        if (!replaced.empty()) {
+            std::lock_guard<std::mutex> lock(retiredMutex);
+            retiredChannels.insert(retiredChannels.end(), replaced.begin(), replaced.end());
+        }
+
+        nextStep += std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(stepSeconds));
+        auto now = clock::now();
+        if (nextStep < now) {
+            nextStep = now; // Fell behind, e.g. while the GUI held the scene: don't try to catch up
+        }
+        std::this_thread::sleep_until(nextStep);
+    }
+}
@@ -0,0 +1,72 @@
+#include "../Headers/SplinePath.h"
+#include "../Headers/ShaderD.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+    // Shared by every path; intentionally never destroyed, like the other render singletons
+    struct SplinePathProgram {
+        ShaderD* shader = nullptr;
+        GLuint emptyVAO = 0; // Core profile draws need a VAO even without attributes
+    };
+
+    SplinePathProgram& getProgram() {
+        static SplinePathProgram* program = nullptr;
+        if (!program) {
+            program = new SplinePathProgram();
+            program->shader = new ShaderD("../Shaders/path_spline.vs", "../Shaders/path.fs");
+            glGenVertexArrays(1, &program->emptyVAO);
+        }
+        return *program;
+    }
+}
+
+SplinePath::SplinePath() {
+    glGenBuffers(1, &buffer);
+    glGenTextures(1, &texture);
+}
+
+SplinePath::~SplinePath() {
+    glDeleteTextures(1, &texture);
+    glDeleteBuffers(1, &buffer);
+}
+
+void SplinePath::setControlPoints(const std::vector<glm::vec3>& points) {
+    // RGB32F buffer textures need GL 4.0, so the points are padded to vec4
+    std::vector<glm::vec4> texels;
+    texels.reserve(points.size());
+    for (const glm::vec3& point : points) {
+        texels.push_back(glm::vec4(point, 1.0f));
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    glBufferData(GL_TEXTURE_BUFFER, texels.size() * sizeof(glm::vec4), texels.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    controlPointCount = static_cast<int>(points.size());
+}
+
+void SplinePath::draw(const glm::mat4& view, const glm::mat4& projection, int sampleCount) const {
+    if (controlPointCount < 2 || sampleCount < 2) return;
+
+    SplinePathProgram& program = getProgram();
+    GLuint id = program.shader->ID;
+    glUseProgram(id);
+    glUniformMatrix4fv(glGetUniformLocation(id, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(id, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    glUniform1i(glGetUniformLocation(id, "controlPointCount"), controlPointCount);
+    glUniform1i(glGetUniformLocation(id, "sampleCount"), sampleCount);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glUniform1i(glGetUniformLocation(id, "controlPoints"), 0);
+
+    glBindVertexArray(program.emptyVAO);
+    glDrawArrays(GL_LINE_STRIP, 0, sampleCount);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
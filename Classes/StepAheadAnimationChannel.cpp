@@ -1,7 +1,11 @@
 #include "../Headers/StepAheadAnimationChannel.h"
+#include "../Headers/Trace.h"
+
+#include <algorithm>
+#include <sstream>
 
 StepAheadAnimationChannel::StepAheadAnimationChannel(const std::string& name)
-    : Channel(name, STEP_AHEAD_ANIMATION), model(nullptr), shader(nullptr), currentTime(0.0f) {
+    : Channel(name, STEP_AHEAD_ANIMATION), currentTime(0.0f) {
 
     if (name == "sun") {
         lightPosition = glm::vec3(0.0f, 100.0f, 100.0f); // Light source for the sun, far and bright
@@ -23,55 +27,65 @@ StepAheadAnimationChannel::StepAheadAnimationChannel(const std::string& name)
 }
 
 void StepAheadAnimationChannel::update(float deltaTime) {
-    if (animationFinished) return;
-
-    if (!stored) {
-		storeOriginalPositions();
-        stored = true;
-	}
+    seek(currentTime + deltaTime); // deltaTime is negative while ping-ponging back
+}
 
-    currentTime += deltaTime;
+void StepAheadAnimationChannel::seek(float localTime) {
+    currentTime = localTime;
+    if (!model || keyFrames.empty()) return;
 
-    if (currentTime >= keyFrames.back().timestamp) {
-        currentTime = keyFrames.back().timestamp;
-        interpolateControlPoints();
-        interpolateKeyFrame();
-        applyFFD();
+    // Past the end the channel shows the first keyframe's pose, see evaluate()
+    animationFinished = currentTime >= keyFrames.back().timestamp;
 
-        // Set to the first keyframe's position, rotation, and scale
-        interpolatedPosition = keyFrames.front().position;
-        interpolatedRotation = keyFrames.front().rotation;
-        interpolatedScale = keyFrames.front().scale;
+    // Looping over the same times reuses earlier deformations instead of running FFD again
+    ChannelState state = evaluateCached(currentTime);
+    interpolatedPosition = state.position;
+    interpolatedRotation = state.rotation;
+    interpolatedScale = state.scale;
+    deformedPositions = state.deformedPositions;
+}
 
-        // Reset model's meshes to the original positions of the first keyframe's control points
-        for (auto& mesh : model->meshes) {
-            size_t numControlPoints = keyFrames.front().ffdControlPoints.size();
-            for (size_t i = 0; i < mesh.vertices.size(); ++i) {
-                if (i < numControlPoints) {
-                    mesh.vertices[i].Position = keyFrames.front().ffdControlPoints[i].originalPosition;
-                }
-                else {
-                    // If there are more vertices than control points, ensure they are reset too
-                    mesh.vertices[i] = originalPositions[i];
-                }
-            }
-            // Update the mesh data
-            mesh.updateMeshData();
-        }
-
-        // Mark animation as finished
-        animationFinished = true;
+ChannelState StepAheadAnimationChannel::evaluate(float time) const {
+    ChannelState state;
+    state.hasTransform = true;
+    if (keyFrames.empty()) {
+        state.position = interpolatedPosition;
+        state.rotation = interpolatedRotation;
+        state.scale = interpolatedScale;
+        return state;
     }
-    else {
-        interpolateControlPoints();
-        interpolateKeyFrame();
-        applyFFD();
+
+    evaluateTransform(time, state.position, state.rotation, state.scale);
+
+    std::vector<FFDControlPoint> controlPoints = evaluateControlPoints(time);
+    if (model && !controlPoints.empty()) {
+        auto deformed = std::make_shared<DeformedPositions>();
+        applyFFD(controlPoints, *deformed);
+        state.deformedPositions = deformed;
     }
+    return state;
 }
 
 void StepAheadAnimationChannel::render(const glm::mat4& view, const glm::mat4& projection) {
+    renderState(captureState(), view, projection);
+}
+
+ChannelState StepAheadAnimationChannel::captureState() const {
+    ChannelState state;
+    state.hasTransform = true;
+    state.position = interpolatedPosition;
+    state.rotation = interpolatedRotation;
+    state.scale = interpolatedScale;
+    state.deformedPositions = deformedPositions;
+    return state;
+}
+
+void StepAheadAnimationChannel::renderState(const ChannelState& state, const glm::mat4& view, const glm::mat4& projection) {
     if (!shader || !model) return;
 
+    // Uploads the captured deformation only if it changed since the last draw
+    model->setDeformedPositions(state.deformedPositions);
+
     // Use the shader program
     shader->use();
 
@@ -80,7 +94,7 @@ void StepAheadAnimationChannel::render(const glm::mat4& view, const glm::mat4& p
     shader->setMat4("projection", projection);
 
     // Get the interpolated model matrix
-    glm::mat4 modelMatrix = getModelMatrix();
+    glm::mat4 modelMatrix = getModelMatrix(state.position, state.rotation, state.scale);
 
     // Set the model matrix uniform
     shader->setMat4("model", modelMatrix);
@@ -102,148 +116,155 @@ void StepAheadAnimationChannel::render(const glm::mat4& view, const glm::mat4& p
     glDisable(GL_CULL_FACE);
 }
 
-void StepAheadAnimationChannel::importObject(const std::string& path) {
+std::shared_ptr<Channel> StepAheadAnimationChannel::clone() const {
+    auto copy = std::make_shared<StepAheadAnimationChannel>(name);
+    copy->copyChannelState(*this);
     if (model) {
-        delete model;
-    }
-    model = new Model(path.c_str());
-}
-
-void StepAheadAnimationChannel::setupShader(const std::string& vertexPath, const std::string& fragmentPath) {
-    if (shader) {
-        delete shader;
+        copy->model = std::make_unique<ModelInstance>(model->getSharedAsset()); // Same asset, own buffers
     }
-    shader = new Shader(("../Shaders/" + vertexPath).c_str(), ("../Shaders/" + fragmentPath).c_str());
+    copy->shader = shader;
+    copy->objectPath = objectPath;
+    copy->vertexShaderPath = vertexShaderPath;
+    copy->fragmentShaderPath = fragmentShaderPath;
+    copy->currentTime = currentTime;
+    copy->rotationInterpolation = rotationInterpolation;
+    copy->rotationTrack = rotationTrack;
+    copy->compressedPlayback = compressedPlayback;
+    copy->compressionTolerance = compressionTolerance;
+    copy->compressedTrack = compressedTrack;
+    copy->deformedPositions = deformedPositions;
+    copy->interpolatedPosition = interpolatedPosition;
+    copy->interpolatedRotation = interpolatedRotation;
+    copy->interpolatedScale = interpolatedScale;
+    copy->lightPosition = lightPosition;
+    copy->viewPosition = viewPosition;
+    return copy;
 }
 
-void StepAheadAnimationChannel::interpolateControlPoints() {
-    if (keyFrames.empty()) return;
-
-    if (keyFrames.size() < 2) {
-        currentControlPoints = keyFrames.front().ffdControlPoints;
+void StepAheadAnimationChannel::importObject(const std::string& path) {
+    // Channels importing the same file share one asset; only the deformation is per channel
+    std::shared_ptr<const ModelAsset> asset = ModelCache::getInstance().load(path);
+    if (!asset) {
+        model.reset();
+        objectPath.clear();
         return;
     }
+    objectPath = path;
+    model = std::make_unique<ModelInstance>(asset);
+    deformedPositions.reset(); // The previous deformation belongs to the previous mesh
+    markChanged();
+}
 
-    KeyFrame* prevKeyFrame = nullptr;
-    KeyFrame* nextKeyFrame = nullptr;
+void StepAheadAnimationChannel::setupShader(const std::string& vertexPath, const std::string& fragmentPath) {
+    shader = std::make_shared<Shader>(("../Shaders/" + vertexPath).c_str(), ("../Shaders/" + fragmentPath).c_str());
+    vertexShaderPath = vertexPath;
+    fragmentShaderPath = fragmentPath;
+}
 
-    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
-        if (currentTime >= keyFrames[i].timestamp && currentTime <= keyFrames[i + 1].timestamp) {
-            prevKeyFrame = &keyFrames[i];
-            nextKeyFrame = &keyFrames[i + 1];
-            break;
-        }
-    }
+void StepAheadAnimationChannel::setRotationInterpolation(RotationInterpolation interpolation) {
+    rotationInterpolation = interpolation;
+    markChanged();
+}
 
-    if (!prevKeyFrame || !nextKeyFrame) return;
+void StepAheadAnimationChannel::onChanged() {
+    rotationTrack.build(tracks.rotation.values); // Same keys as the rotation track
 
-    float t = (currentTime - prevKeyFrame->timestamp) / (nextKeyFrame->timestamp - prevKeyFrame->timestamp);
+    compressedTrack = compressedPlayback ? CompressedTrack::compress(keyFrames, compressionTolerance) : CompressedTrack();
+}
 
-    currentControlPoints.resize(prevKeyFrame->ffdControlPoints.size());
-    for (size_t i = 0; i < prevKeyFrame->ffdControlPoints.size(); ++i) {
-        currentControlPoints[i].position = glm::mix(prevKeyFrame->ffdControlPoints[i].position,
-            nextKeyFrame->ffdControlPoints[i].position, t);
+void StepAheadAnimationChannel::setCompressedPlayback(bool enabled, const CompressionTolerance& tolerance) {
+    compressedPlayback = enabled;
+    compressionTolerance = tolerance;
+    markChanged();
+}
 
-        // Keep original positions and weights constant
-        currentControlPoints[i].originalPosition = prevKeyFrame->ffdControlPoints[i].originalPosition;
-        currentControlPoints[i].weight = prevKeyFrame->ffdControlPoints[i].weight;
+void StepAheadAnimationChannel::writeSceneSettings(std::ostream& out) const {
+    out << "Set Rotation: " << (rotationInterpolation == RotationInterpolation::SQUAD ? "squad" : "slerp") << "\n";
+    if (compressedPlayback) {
+        out << "Set Compression: " << compressionTolerance.position << " " << compressionTolerance.rotation << " " << compressionTolerance.scale << "\n";
+    }
+    if (!objectPath.empty()) {
+        out << "Set Object: " << objectPath << "\n";
+    }
+    if (shader) {
+        out << "Set VertexShader: " << vertexShaderPath << "\n";
+        out << "Set FragmentShader: " << fragmentShaderPath << "\n";
     }
 }
 
-void StepAheadAnimationChannel::applyFFD() {
-    if (!model) {
-        std::cout << "Model not loaded, FFD cannot be applied." << std::endl;
-        return;
+void StepAheadAnimationChannel::readSceneSetting(const std::string& key, const std::string& value) {
+    if (key == "Object") {
+        importObject(value);
     }
-
-    glm::vec3 centerOfMassBefore = glm::vec3(0.0f);
-    glm::vec3 centerOfMassAfter = glm::vec3(0.0f);
-    size_t totalVertices = 0;
-
-    // Calculate initial center of mass
-    for (const auto& mesh : model->meshes) {
-        totalVertices += mesh.vertices.size();
-        for (const auto& vertex : mesh.vertices) {
-            centerOfMassBefore += vertex.Position;
-        }
+    else if (key == "VertexShader") {
+        vertexShaderPath = value;
     }
-    centerOfMassBefore /= static_cast<float>(totalVertices);
-
-    // Apply FFD to the model vertices using control points
-    for (auto& mesh : model->meshes) {
-        for (size_t i = 0; i < mesh.vertices.size(); ++i) {
-            auto& vertex = mesh.vertices[i];
-            glm::vec3 originalPosition = vertex.Position;
-            glm::vec3 displacement = glm::vec3(0.0f);
-            float totalWeight = 0.0f;
-
-            for (const auto& cp : currentControlPoints) {
-                float distance = glm::length(originalPosition - cp.originalPosition);
-                float weight = cp.weight / (distance + 1.0f);
-                displacement += weight * (cp.position - cp.originalPosition);
-                totalWeight += weight;
-            }
-
-            if (totalWeight > 0.0f) {
-                displacement /= totalWeight;
-            }
+    else if (key == "FragmentShader") {
+        setupShader(vertexShaderPath, value); // Written right after the vertex shader
+    }
+    else if (key == "Compression") {
+        CompressionTolerance tolerance;
+        std::istringstream in(value);
+        in >> tolerance.position >> tolerance.rotation >> tolerance.scale;
+        setCompressedPlayback(true, tolerance);
+    }
+    else if (key == "Rotation") {
+        setRotationInterpolation(value == "slerp" ? RotationInterpolation::SLERP : RotationInterpolation::SQUAD);
+    }
+}
 
-            glm::vec3 newPosition = originalPosition + displacement;
-            vertex.Position = newPosition;
-            centerOfMassAfter += newPosition;
-        }
+void StepAheadAnimationChannel::evaluateTransform(float time, glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const {
+    // A finished animation shows the first keyframe's pose
+    if (time >= tracks.getEndTime()) {
+        time = tracks.getStartTime();
     }
 
-    // Calculate new center of mass
-    centerOfMassAfter /= static_cast<float>(totalVertices);
+    if (compressedPlayback && !compressedTrack.isEmpty()) {
+        position = compressedTrack.samplePosition(time);
+        rotation = compressedTrack.sampleRotation(time);
+        scale = compressedTrack.sampleScale(time);
+        return;
+    }
 
-    // Adjust vertices to maintain the same center of mass
-    glm::vec3 correction = centerOfMassBefore - centerOfMassAfter;
+    position = tracks.samplePosition(time);
+    scale = tracks.sampleScale(time);
 
-    for (auto& mesh : model->meshes) {
-        for (auto& vertex : mesh.vertices) {
-            vertex.Position += correction;
-        }
-        mesh.updateMeshData();
+    size_t i;
+    float t;
+    if (rotationInterpolation == RotationInterpolation::SQUAD && rotationTrack.size() == tracks.rotation.size()
+        && tracks.rotation.findSegment(time, i, t)) {
+        rotation = rotationTrack.evaluate(i, t);
+    }
+    else {
+        rotation = tracks.sampleRotation(time);
     }
 }
 
-void StepAheadAnimationChannel::interpolateKeyFrame() {
-    if (keyFrames.size() < 2) return;
-
-    const KeyFrame* prevKeyFrame = nullptr;
-    const KeyFrame* nextKeyFrame = nullptr;
-
-    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
-        if (currentTime >= keyFrames[i].timestamp && currentTime <= keyFrames[i + 1].timestamp) {
-            prevKeyFrame = &keyFrames[i];
-            nextKeyFrame = &keyFrames[i + 1];
-            break;
-        }
+std::vector<FFDControlPoint> StepAheadAnimationChannel::evaluateControlPoints(float time) const {
+    std::vector<FFDControlPoint> controlPoints;
+    if (keyFrames.size() >= 2 && time >= tracks.getEndTime()) {
+        return controlPoints; // Finished: rest pose
     }
+    tracks.sampleControlPoints(time, controlPoints);
+    return controlPoints;
+}
 
-    if (!prevKeyFrame || !nextKeyFrame) return;
-
-    float t = (currentTime - prevKeyFrame->timestamp) / (nextKeyFrame->timestamp - prevKeyFrame->timestamp);
-
-    interpolatedPosition = glm::mix(prevKeyFrame->position, nextKeyFrame->position, t);
-    interpolatedRotation = glm::slerp(prevKeyFrame->rotation, nextKeyFrame->rotation, t);
-    interpolatedScale = glm::mix(prevKeyFrame->scale, nextKeyFrame->scale, t);
+// Deforms the rest pose (never the previous result), so the outcome depends only on the control points
+void StepAheadAnimationChannel::applyFFD(const std::vector<FFDControlPoint>& controlPoints, DeformedPositions& deformed) const {
+    TRACE_SCOPE("StepAheadAnimationChannel::applyFFD");
+    const auto& meshes = model->getAsset().getMeshes();
+    std::vector<const std::vector<glm::vec3>*> restMeshes;
+    restMeshes.reserve(meshes.size());
+    for (const auto& mesh : meshes) {
+        restMeshes.push_back(&mesh.restPositions);
+    }
+    deformFFD(restMeshes, controlPoints, deformed);
 }
 
-glm::mat4 StepAheadAnimationChannel::getModelMatrix() const {
+glm::mat4 StepAheadAnimationChannel::getModelMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
     glm::mat4 modelMatrix = glm::mat4(1.0f);
-    modelMatrix = glm::translate(modelMatrix, interpolatedPosition); // Apply translation
-    modelMatrix *= glm::toMat4(interpolatedRotation); // Apply rotation
-    modelMatrix = glm::scale(modelMatrix, interpolatedScale); // Apply scale
+    modelMatrix = glm::translate(modelMatrix, position); // Apply translation
+    modelMatrix *= glm::toMat4(rotation); // Apply rotation
+    modelMatrix = glm::scale(modelMatrix, scale); // Apply scale
     return modelMatrix;
 }
-
-void StepAheadAnimationChannel::storeOriginalPositions() {
-    originalPositions.clear();
-    for (const auto& mesh : model->meshes) {
-        for (const auto& vertex : mesh.vertices) {
-            originalPositions.push_back(vertex);
-        }
-    }
-}
@@ -1,26 +1,10 @@
 #include "../Headers/StickFigure.h"
+#include "../Headers/Trace.h"
+
+#include <algorithm>
 
 StickFigure::StickFigure() {
-    // Define the skeleton structure with joint names, positions, rotations, and scales
-    skeleton.push_back(createJoint("Head", glm::vec3(0.0f, 0.6f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.7f, 0.5f, 1.5f)));
-    skeleton.push_back(createJoint("Torso", glm::vec3(0.0f, 1.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.5f, 0.5f)));
-    skeleton.push_back(createJoint("Left Arm", glm::vec3(-0.18f, 0.15f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.25f)));
-    skeleton.push_back(createJoint("Right Arm", glm::vec3(0.18f, 0.15f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(-45.0f), glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(0.25f)));
-    skeleton.push_back(createJoint("Left Leg", glm::vec3(-0.1f, -0.55f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.25f, 0.7f, 0.25f)));
-    skeleton.push_back(createJoint("Right Leg", glm::vec3(0.1f, -0.55f, 0.0f), glm::rotate(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.25f, 0.7f, 0.25f)));
-
-    // Adding hands as child joints of the arms
-    skeleton.push_back(createJoint("Left Hand", glm::vec3(0.0f, 0.8f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f, 0.7f, 0.5f)));
-    skeleton.push_back(createJoint("Right Hand", glm::vec3(0.0f, 0.8f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.5f, 0.7f, 0.5f)));
-
-    // Define parent-child relationships
-    skeleton[1].childrenIndices.push_back(0); // Torso -> Head
-    skeleton[1].childrenIndices.push_back(2); // Torso -> Left Arm
-    skeleton[1].childrenIndices.push_back(3); // Torso -> Right Arm
-    skeleton[1].childrenIndices.push_back(4); // Torso -> Left Leg
-    skeleton[1].childrenIndices.push_back(5); // Torso -> Right Leg
-    skeleton[2].childrenIndices.push_back(6); // Left Arm -> Left Hand
-    skeleton[3].childrenIndices.push_back(7); // Right Arm -> Right Hand
+    skeleton = createStickFigureSkeleton();
 
     // Shaders
     shader = new Shader("../Shaders/stick_figure.vs", "../Shaders/stick_figure.fs");
@@ -30,33 +14,30 @@ StickFigure::StickFigure() {
     setupSphere();
 }
 
-glm::mat4 StickFigure::getJointModelMatrix(const Joint& joint) {
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), joint.position);
-    model *= glm::toMat4(joint.rotation);
-    model = glm::scale(model, joint.scale);
-    return model;
+StickFigure::~StickFigure() {
+    GLuint vertexArrays[] = { cylinderVAO, sphereVAO };
+    GLuint buffers[] = { cylinderVBO, cylinderEBO, sphereVBO, sphereEBO };
+    glDeleteVertexArrays(2, vertexArrays); // Zero names are ignored
+    glDeleteBuffers(4, buffers);
+    if (shader) {
+        glDeleteProgram(shader->ID);
+        delete shader;
+    }
 }
 
 void StickFigure::render(const glm::mat4& view, const glm::mat4& projection) {
+    TRACE_SCOPE("StickFigure::render");
     if (!shader) return;
 
-    std::function<void(int, glm::mat4)> renderJoint = [&](int jointIndex, glm::mat4 parentMatrix) {
-        const auto& joint = skeleton[jointIndex];
-        glm::mat4 modelMatrix = parentMatrix * getJointModelMatrix(joint);
-
-        if (joint.name == "Head") {
-            drawSphere(modelMatrix, view, projection); // Draw head or hand
+    computeJointMatrices(skeleton, jointMatrices);
+    for (size_t i = 0; i < skeleton.size(); ++i) {
+        if (skeleton[i].name == "Head") {
+            drawSphere(jointMatrices[i], view, projection); // Draw head or hand
         }
         else {
-            drawCylinder(modelMatrix, view, projection); // Draw limbs
-        }
-
-        for (int childIndex : joint.childrenIndices) {
-            renderJoint(childIndex, modelMatrix);
+            drawCylinder(jointMatrices[i], view, projection); // Draw limbs
         }
-        };
-
-    renderJoint(1, glm::mat4(1.0f)); // Start with the torso as the root (index 1)
+    }
 }
 
 
@@ -113,10 +94,6 @@ void StickFigure::drawSphere(const glm::mat4& modelMatrix, const glm::mat4& view
 
 
 
-Joint StickFigure::createJoint(const std::string& name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
-    return { name, position, rotation, scale };
-}
-
 void StickFigure::setupCylinder() {
     const int segments = 20;
     const float height = 1.0f;
@@ -166,7 +143,6 @@ void StickFigure::setupCylinder() {
     // Generate and bind the VAO and VBO
     glGenVertexArrays(1, &cylinderVAO);
     glGenBuffers(1, &cylinderVBO);
-    GLuint cylinderEBO;
     glGenBuffers(1, &cylinderEBO);
 
     glBindVertexArray(cylinderVAO);
@@ -240,7 +216,6 @@ void StickFigure::setupSphere() {
     // Generate and bind the VAO and VBO
     glGenVertexArrays(1, &sphereVAO);
     glGenBuffers(1, &sphereVBO);
-    GLuint sphereEBO;
     glGenBuffers(1, &sphereEBO);
 
     glBindVertexArray(sphereVAO);
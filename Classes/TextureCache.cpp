@@ -0,0 +1,128 @@
+#include "../Headers/TextureCache.h"
+#include "../Headers/FileKey.h"
+
+#include <stb_image.h>
+#include <iostream>
+
+namespace {
+    GLenum formatForChannels(int nrChannels) {
+        switch (nrChannels) {
+        case 1: return GL_RED;
+        case 4: return GL_RGBA;
+        default: return GL_RGB;
+        }
+    }
+}
+
+TextureCache& TextureCache::getInstance() {
+    // Intentionally never destroyed: channels held by global animations may release
+    // their textures during static destruction, after a function-local static would be gone
+    static TextureCache* instance = new TextureCache();
+    return *instance;
+}
+
+std::shared_ptr<CachedTexture> TextureCache::find(const std::string& key) const {
+    auto it = entries.find(key);
+    return (it != entries.end()) ? it->second.lock() : nullptr;
+}
+
+std::shared_ptr<CachedTexture> TextureCache::insert(const std::string& key, CachedTexture* texture) {
+    residentBytes += texture->byteSize;
+
+    std::shared_ptr<CachedTexture> shared(texture, [key](CachedTexture* t) {
+        TextureCache::getInstance().release(key, t);
+    });
+    entries[key] = shared;
+    return shared;
+}
+
+// Called when the last user of a texture goes away
+void TextureCache::release(const std::string& key, CachedTexture* texture) {
+    if (texture->id != 0) {
+        glDeleteTextures(1, &texture->id);
+    }
+    residentBytes -= texture->byteSize;
+
+    // Only drop the entry if it was not replaced by a newer load in the meantime
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.expired()) {
+        entries.erase(it);
+    }
+    delete texture;
+}
+
+std::shared_ptr<CachedTexture> TextureCache::loadTexture2D(const std::string& path) {
+    std::string key = "2D:" + makeFileCacheKey(path);
+    if (auto cached = find(key)) {
+        return cached;
+    }
+
+    int width, height, nrChannels;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
+    if (!data) {
+        std::cerr << "Failed to load texture: " << path << std::endl;
+        return nullptr;
+    }
+
+    CachedTexture* texture = new CachedTexture();
+    texture->target = GL_TEXTURE_2D;
+    glGenTextures(1, &texture->id);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+
+    // Set the texture wrapping parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    // Set texture filtering parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    GLenum format = formatForChannels(nrChannels);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    stbi_image_free(data);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    texture->byteSize = static_cast<size_t>(width) * height * nrChannels * 4 / 3; // Mip chain adds ~1/3
+    return insert(key, texture);
+}
+
+std::shared_ptr<CachedTexture> TextureCache::loadCubemap(const std::vector<std::string>& faces) {
+    std::string key = "CUBE:";
+    for (const auto& face : faces) {
+        key += makeFileCacheKey(face) + ";";
+    }
+    if (auto cached = find(key)) {
+        return cached;
+    }
+
+    CachedTexture* texture = new CachedTexture();
+    texture->target = GL_TEXTURE_CUBE_MAP;
+    glGenTextures(1, &texture->id);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture->id);
+
+    int width, height, nrChannels;
+    for (unsigned int i = 0; i < faces.size(); i++) {
+        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
+        if (data) {
+            GLenum format = formatForChannels(nrChannels);
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+                0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data
+            );
+            texture->byteSize += static_cast<size_t>(width) * height * nrChannels;
+            stbi_image_free(data);
+        }
+        else {
+            std::cerr << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
+        }
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    return insert(key, texture);
+}
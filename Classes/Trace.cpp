@@ -0,0 +1,151 @@
+#include "../Headers/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // One ring per thread with a single writer, so recording needs no lock. Slots are relaxed
+    // atomics so a dump running concurrently reads stale or fresh values, never torn ones;
+    // it discards whatever the writer may have lapped while it was copying.
+    struct TraceSlot {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> startNs{ 0 };
+        std::atomic<uint64_t> endNs{ 0 };
+    };
+
+    struct ThreadRing {
+        static const uint64_t capacity = 1 << 16; // Power of two, ~1.5 MB per thread
+
+        int threadId = 0;
+        std::atomic<const char*> threadName{ nullptr };
+        std::atomic<uint64_t> writeIndex{ 0 };
+        std::vector<TraceSlot> slots;
+
+        ThreadRing() : slots(capacity) {}
+    };
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    // Rings are never freed: worker threads may exit before a dump and their events should survive
+    std::mutex registryMutex;
+    std::vector<ThreadRing*>& registry() {
+        static std::vector<ThreadRing*>* rings = new std::vector<ThreadRing*>();
+        return *rings;
+    }
+
+    ThreadRing& currentRing() {
+        thread_local ThreadRing* ring = nullptr;
+        if (!ring) {
+            ring = new ThreadRing();
+            std::lock_guard<std::mutex> lock(registryMutex);
+            ring->threadId = static_cast<int>(registry().size());
+            registry().push_back(ring);
+        }
+        return *ring;
+    }
+
+    const auto origin = std::chrono::steady_clock::now();
+
+    std::string escapeJson(const char* text) {
+        std::string escaped;
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(*text) < 0x20) continue;
+            escaped += *text;
+        }
+        return escaped;
+    }
+}
+
+std::atomic<bool> Trace::capturing{ false };
+
+void Trace::setCapturing(bool enabled) {
+    capturing.store(enabled, std::memory_order_relaxed);
+}
+
+bool Trace::isCapturing() {
+    return capturing.load(std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const char* name) {
+    currentRing().threadName.store(name, std::memory_order_relaxed);
+}
+
+uint64_t Trace::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Trace::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = currentRing();
+    uint64_t index = ring.writeIndex.load(std::memory_order_relaxed);
+    TraceSlot& slot = ring.slots[index & (ThreadRing::capacity - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.endNs.store(endNs, std::memory_order_relaxed);
+    ring.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::dump(const std::string& path) {
+    std::vector<ThreadRing*> rings;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rings = registry();
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    size_t eventCount = 0;
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (ThreadRing* ring : rings) {
+        const char* threadName = ring->threadName.load(std::memory_order_relaxed);
+        if (threadName) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+                << ",\"args\":{\"name\":\"" << escapeJson(threadName) << "\"}}";
+            first = false;
+        }
+
+        uint64_t end = ring->writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > ThreadRing::capacity ? end - ThreadRing::capacity : 0;
+        std::vector<TraceEvent> events;
+        events.reserve(static_cast<size_t>(end - begin));
+        for (uint64_t i = begin; i < end; ++i) {
+            const TraceSlot& slot = ring->slots[i & (ThreadRing::capacity - 1)];
+            events.push_back({ slot.name.load(std::memory_order_relaxed),
+                slot.startNs.load(std::memory_order_relaxed), slot.endNs.load(std::memory_order_relaxed) });
+        }
+
+        // Slots the owner reused while they were being copied hold newer events; drop them,
+        // plus the slot for endAfterCopy, which the owner may be writing right now
+        uint64_t endAfterCopy = ring->writeIndex.load(std::memory_order_acquire);
+        uint64_t firstIntact = endAfterCopy + 1 > ThreadRing::capacity ? endAfterCopy + 1 - ThreadRing::capacity : 0;
+        size_t skip = static_cast<size_t>(std::min<uint64_t>(firstIntact > begin ? firstIntact - begin : 0, events.size()));
+
+        for (size_t i = skip; i < events.size(); ++i) {
+            const TraceEvent& event = events[i];
+            if (!event.name) continue;
+            out << (first ? "" : ",\n") << "{\"name\":\"" << escapeJson(event.name) << "\",\"ph\":\"X\",\"ts\":"
+                << event.startNs / 1000 << "." << (event.startNs % 1000) / 100 << ",\"dur\":"
+                << (event.endNs - event.startNs) / 1000 << "." << ((event.endNs - event.startNs) % 1000) / 100
+                << ",\"pid\":1,\"tid\":" << ring->threadId << "}";
+            first = false;
+            ++eventCount;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::cout << "Wrote " << eventCount << " trace events to " << path << std::endl;
+    return out.good();
+}
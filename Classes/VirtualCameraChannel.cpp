@@ -1,172 +1,261 @@
 #include "../Headers/VirtualCameraChannel.h"
-
-std::vector<float> t_values;
-std::vector<float> timeStamps;
-std::vector<glm::vec3> drawnSpeedCurve;
+#include "../Headers/Animation.h"
+#include "../Headers/ShaderD.h"
+#include "../Headers/SplinePath.h"
+#include "../Headers/Trace.h"
+#include "../Headers/Core/CameraPath.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+
+namespace {
+    const int SPEED_PROFILE_SAMPLES = 128;
+}
 
 VirtualCameraChannel::VirtualCameraChannel(const std::string& name)
-    : Channel(name, ChannelType::VIRTUAL_CAMERA), isInitialized(false), pathShader(nullptr), isTraversalInProgress(false) {
+    : Channel(name, ChannelType::VIRTUAL_CAMERA), isInitialized(false), isTraversalInProgress(false) {
+}
+
+VirtualCameraChannel::~VirtualCameraChannel() {
+    if (isInitialized) {
+        GLuint vertexArrays[] = { pathVAO, keyframeVAO, speedCurveVAO };
+        GLuint buffers[] = { pathVBO, keyframeVBO, speedCurveVBO };
+        glDeleteVertexArrays(3, vertexArrays);
+        glDeleteBuffers(3, buffers);
+    }
+}
+
+std::shared_ptr<Channel> VirtualCameraChannel::clone() const {
+    auto copy = std::make_shared<VirtualCameraChannel>(name); // GL objects are created on first render
+    copy->copyChannelState(*this);
+    copy->isTraversalInProgress = isTraversalInProgress;
+    copy->currentTime = currentTime;
+    copy->traversalComplete = traversalComplete;
+    copy->path = path;
+    copy->speedProfile = speedProfile;
+    copy->speedCurveInScene = speedCurveInScene;
+    copy->traversalStarted = traversalStarted;
+    copy->cursor = cursor;
+    copy->aim = aim;
+    copy->lookAtPoint = lookAtPoint;
+    copy->lookAtHandle = lookAtHandle;
+    copy->lookAtChannel = lookAtChannel;
+    copy->cameraPosition = cameraPosition;
+    copy->cameraFront = cameraFront;
+    copy->pathDisplay = pathDisplay;
+    copy->splineSampleCount = splineSampleCount;
+    copy->pathTolerance = pathTolerance;
+    copy->uploadedSpeedCurveVersion = ~0ull;
+    copy->pathShader = pathShader; // Buffers are the copy's own, created on its first render
+    copy->keyframeShader = keyframeShader;
+    copy->speedCurveShader = speedCurveShader;
+    return copy;
 }
 
 void VirtualCameraChannel::startTraversal() {
     currentTime = 0.0f; // Reset the current time for traversal
     traversalComplete = false; // Reset the completion flag
     isTraversalInProgress = true; // Set the traversal in progress flag
-    interpolatedKeyFrames = interpolateKeyFrames(); // Generate interpolated keyframes
+    traversalStarted = true;
+    cursor = CameraPath::Cursor();
+    markChanged(); // evaluate() follows the path from now on
 }
 
-float VirtualCameraChannel::easeInOutCubic(float t) {
-    float easedValue = t < 0.5f ? 4.0f * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
-    return easedValue;
+void VirtualCameraChannel::setSpeedCurve(const SpeedCurve& curve) {
+    path.setSpeedCurve(curve);
+    markChanged();
 }
 
-// interpolate functions
-glm::vec3 VirtualCameraChannel::interpolateScale(float time) const {
-    if (keyFrames.empty()) return glm::vec3(1.0f);
-    if (time <= keyFrames.front().timestamp) return keyFrames.front().scale;
-    if (time >= keyFrames.back().timestamp) return keyFrames.back().scale;
+void VirtualCameraChannel::onChanged() {
+    TRACE_SCOPE("VirtualCameraChannel::buildPath"); // Core/ kernels are not traced themselves
+    path.build(keyFrames);
+    speedProfile = path.speedProfile(SPEED_PROFILE_SAMPLES);
+}
 
-    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
-        if (time >= keyFrames[i].timestamp && time <= keyFrames[i + 1].timestamp) {
-            return glm::mix(keyFrames[i].scale, keyFrames[i + 1].scale, (time - keyFrames[i].timestamp) / (keyFrames[i + 1].timestamp - keyFrames[i].timestamp));
-        }
-    }
-    return glm::vec3(1.0f); // Should never reach here
+void VirtualCameraChannel::setAim(CameraAim aim) {
+    this->aim = aim;
+    markChanged();
 }
 
-glm::vec3 VirtualCameraChannel::bezierInterpolate(const std::vector<glm::vec3>& points, float t) const {
-    if (points.size() == 1) {
-        return points[0];
-    }
+void VirtualCameraChannel::setLookAtPoint(const glm::vec3& point) {
+    lookAtPoint = point;
+    markChanged();
+}
 
-    std::vector<glm::vec3> newPoints;
-    for (size_t i = 0; i < points.size() - 1; ++i) {
-        newPoints.push_back(glm::mix(points[i], points[i + 1], t));
-    }
+bool VirtualCameraChannel::setLookAtChannel(Animation& animation, ChannelHandle target) {
+    if (target == lookAtHandle) return true;
 
-    return bezierInterpolate(newPoints, t);
+    // The edge goes through the animation, which refuses it if the target already depends on the camera
+    if (target != INVALID_CHANNEL_HANDLE && !dependsOn(target) && !animation.addDependency(getHandle(), target)) {
+        return false; // Keeps the previous target
+    }
+    removeDependency(lookAtHandle);
+    lookAtHandle = target;
+    lookAtChannel = animation.getChannel(target);
+    markChanged();
+    return true;
 }
 
-glm::quat VirtualCameraChannel::bezierInterpolate(const std::vector<glm::quat>& points, float t) const {
-    if (points.size() == 1) {
-        return points[0];
+void VirtualCameraChannel::resolveReferences(const Animation& animation) {
+    if (lookAtHandle == INVALID_CHANNEL_HANDLE) return;
+    auto channel = animation.getChannel(lookAtHandle);
+    if (channel != lookAtChannel.lock()) {
+        lookAtChannel = channel;
+        markChanged(); // Evaluated poses depended on the previous target
     }
+}
 
-    std::vector<glm::quat> newPoints;
-    for (size_t i = 0; i < points.size() - 1; ++i) {
-        newPoints.push_back(glm::slerp(points[i], points[i + 1], t));
+void VirtualCameraChannel::writeSceneSettings(std::ostream& out) const {
+    const char* aims[] = { "point", "keyframed", "channel" };
+    out << "Set CameraAim: " << aims[static_cast<int>(aim)] << "\n";
+    out << "Set LookAtPoint: " << lookAtPoint.x << " " << lookAtPoint.y << " " << lookAtPoint.z << "\n";
+    // The look-at channel is written by saveScene, it needs the other channels to exist
+
+    const SpeedCurve& curve = path.getSpeedCurve();
+    const char* profiles[] = { "constant", "ease", "custom" };
+    out << "Set SpeedProfile: " << profiles[static_cast<int>(curve.profile)] << "\n";
+    if (!curve.points.empty()) {
+        out << "Set SpeedCurve:";
+        for (const glm::vec2& point : curve.points) {
+            out << " " << point.x << " " << point.y;
+        }
+        out << "\n";
     }
-
-    return bezierInterpolate(newPoints, t);
 }
 
-glm::vec3 VirtualCameraChannel::interpolatePosition(float time) const {
-    if (keyFrames.empty()) return glm::vec3(0.0f);
-    if (time <= keyFrames.front().timestamp) return keyFrames.front().position;
-    if (time >= keyFrames.back().timestamp) return keyFrames.back().position;
-
-    // Collect all control points from keyFrames
-    std::vector<glm::vec3> controlPoints;
-    for (const auto& keyFrame : keyFrames) {
-        controlPoints.push_back(keyFrame.position);
+void VirtualCameraChannel::readSceneSetting(const std::string& key, const std::string& value) {
+    if (key == "CameraAim") {
+        setAim(value == "keyframed" ? CameraAim::KEYFRAMED : value == "channel" ? CameraAim::LOOK_AT_CHANNEL : CameraAim::LOOK_AT_POINT);
+        return;
+    }
+    if (key == "LookAtPoint") {
+        std::istringstream in(value);
+        glm::vec3 point(0.0f);
+        in >> point.x >> point.y >> point.z;
+        setLookAtPoint(point);
+        return;
     }
 
-    // Calculate t for the whole curve
-    float totalTime = keyFrames.back().timestamp - keyFrames.front().timestamp;
-    float t = (time - keyFrames.front().timestamp) / totalTime;
-
-    // Apply easing function
-    t = easeInOutCubic(t);
-    
-    if (timeStamps.size() < 2 + (keyFrames.size() - 1) * (frameRate - 1))
-    {
-        t_values.push_back(t);
-        timeStamps.push_back(time);
-    }        
-
-    return bezierInterpolate(controlPoints, t);
+    SpeedCurve curve = path.getSpeedCurve();
+    if (key == "SpeedProfile") {
+        curve.profile = value == "constant" ? SpeedProfile::CONSTANT : value == "custom" ? SpeedProfile::CUSTOM : SpeedProfile::EASE_IN_OUT;
+    }
+    else if (key == "SpeedCurve") {
+        std::istringstream in(value);
+        glm::vec2 point;
+        curve.points.clear();
+        while (in >> point.x >> point.y) {
+            curve.points.push_back(point);
+        }
+    }
+    else {
+        return;
+    }
+    setSpeedCurve(curve);
 }
 
-glm::quat VirtualCameraChannel::interpolateOrientation(float time) const {
-    if (keyFrames.empty()) return glm::quat();
-    if (time <= keyFrames.front().timestamp) return keyFrames.front().rotation;
-    if (time >= keyFrames.back().timestamp) return keyFrames.back().rotation;
-
-    // Collect all control points from keyFrames
-    std::vector<glm::quat> controlPoints;
-    for (const auto& keyFrame : keyFrames) {
-        controlPoints.push_back(keyFrame.rotation);
+void VirtualCameraChannel::update(float deltaTime) {
+    // Follows the playhead once the path was started, also backwards and after the end (ping-pong)
+    if (traversalStarted) {
+        seek(currentTime + deltaTime);
     }
+}
 
-    // Calculate t for the whole curve
-    float totalTime = keyFrames.back().timestamp - keyFrames.front().timestamp;
-    float t = (time - keyFrames.front().timestamp) / totalTime;
-
-    // Apply easing function
-    t = easeInOutCubic(t);
-
-    return bezierInterpolate(controlPoints, t);
+void VirtualCameraChannel::seek(float localTime) {
+    currentTime = localTime;
+    if (!traversalStarted) return;
+
+    // Sampled at the exact time: the cursor keeps the lookup O(1), so the frame cache is not needed
+    ChannelState state = evaluatePose(currentTime, cursor, true);
+    isTraversalInProgress = state.hasCamera; // Releases the camera past the end of the path
+    traversalComplete = !state.hasCamera;
+    if (state.hasCamera) {
+        cameraPosition = state.cameraPosition;
+        cameraFront = state.cameraFront;
+    }
 }
 
+void VirtualCameraChannel::setPathDisplay(PathDisplay display) {
+    pathDisplay = display;
+    uploadedPathVersion = ~0ull;
+}
 
-void VirtualCameraChannel::update(float deltaTime) {
-    if (isTraversalInProgress && !traversalComplete) {
-        traversePath();
-    }
+void VirtualCameraChannel::setPathTolerance(const PathTolerance& tolerance) {
+    pathTolerance = tolerance;
+    uploadedPathVersion = ~0ull; // Re-tessellate with the new bounds
 }
 
-// Refactored render function
+// Path and keyframe buffers are rebuilt only after the channel changed, unless the path is
+// tessellated against the screen. On the GPU the rebuild is a re-upload of the control points.
 void VirtualCameraChannel::render(const glm::mat4& view, const glm::mat4& projection) {
     if (!isInitialized) {
         initPathRendering();
     }
 
-    std::vector<KeyFrame> interpolatedKeyFrames = interpolateKeyFrames();
-
-    std::vector<glm::vec3> pathPositions;
-    std::vector<glm::vec3> keyframePositions;
-    for (const auto& kf : interpolatedKeyFrames) {
-        pathPositions.push_back(kf.position);
+    bool tessellated = pathDisplay == PathDisplay::TESSELLATED;
+    if (tessellated && pathTolerance.pixels > 0.0f) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        TRACE_SCOPE("VirtualCameraChannel::tessellatePath");
+        PathTolerance tolerance = pathTolerance;
+        tolerance.viewProjection = projection * view;
+        tolerance.viewport = glm::vec2(viewport[2], viewport[3]);
+        uploadPath(path.tessellate(tolerance));
     }
-    for (const auto& kf : keyFrames) {
-        keyframePositions.push_back(kf.position);
-    }
-
-    // Draw the path
-    drawPath(view, projection, pathPositions);
-
-    // Draw the keyframes
-    drawKeyframes(view, projection, keyframePositions);
-
-    // Draw the speed curve
-    // Calculate rate of change
-    std::vector<float> rate_of_change;
-    if (t_values.size() > 1) {
-        for (size_t i = 1; i < t_values.size(); ++i) {
-            float rate = t_values[i] - t_values[i - 1];
-            rate_of_change.push_back(rate);
+    if (uploadedPathVersion != getVersion()) {
+        if (!tessellated) {
+            splinePath->setControlPoints(path.getControlPoints());
         }
-    }   
-
-    std::vector<glm::vec3> speedCurvePositions;
-    if (rate_of_change.size() > 0 && timeStamps.size() > 0) {
-        for (size_t i = 0; i < rate_of_change.size(); ++i) {
-            speedCurvePositions.push_back(glm::vec3(timeStamps[i], rate_of_change[i], 5.0f));
+        else if (pathTolerance.pixels <= 0.0f) {
+            TRACE_SCOPE("VirtualCameraChannel::tessellatePath");
+            uploadPath(path.tessellate(pathTolerance));
         }
+        uploadKeyframes();
+        uploadedPathVersion = getVersion();
+    }
 
-        drawSpeedCurve(view, projection, speedCurvePositions);
-	}
+    if (tessellated) {
+        drawPath(view, projection);
+    }
+    else {
+        splinePath->draw(view, projection, splineSampleCount);
+    }
+    drawKeyframes(view, projection);
+
+    if (speedCurveInScene) {
+        drawSpeedCurve(view, projection);
+    }
 }
 
-// Function to draw the path
-void VirtualCameraChannel::drawPath(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& pathPositions) {
-    // Bind and upload path positions to the VBO
+void VirtualCameraChannel::uploadPath(const std::vector<glm::vec3>& pathPositions) {
     glBindVertexArray(pathVAO);
     glBindBuffer(GL_ARRAY_BUFFER, pathVBO);
     glBufferData(GL_ARRAY_BUFFER, pathPositions.size() * sizeof(glm::vec3), pathPositions.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glBindVertexArray(0);
+    pathVertexCount = static_cast<int>(pathPositions.size());
+}
 
+void VirtualCameraChannel::uploadKeyframes() {
+    std::vector<glm::vec3> keyframePositions;
+    for (const auto& kf : keyFrames) {
+        keyframePositions.push_back(kf.position);
+    }
+
+    glBindVertexArray(keyframeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, keyframeVBO);
+    glBufferData(GL_ARRAY_BUFFER, keyframePositions.size() * sizeof(glm::vec3), keyframePositions.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glBindVertexArray(0);
+    keyframeVertexCount = static_cast<int>(keyframePositions.size());
+}
+
+// Function to draw the path
+void VirtualCameraChannel::drawPath(const glm::mat4& view, const glm::mat4& projection) {
+    if (pathVertexCount < 2) return;
 
     // Use the path shader program
     glUseProgram(pathShader->ID);
@@ -176,21 +265,16 @@ void VirtualCameraChannel::drawPath(const glm::mat4& view, const glm::mat4& proj
     glUniformMatrix4fv(glGetUniformLocation(pathShader->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
     // Draw the path
-    glDrawArrays(GL_LINE_STRIP, 0, pathPositions.size());
+    glBindVertexArray(pathVAO);
+    glDrawArrays(GL_LINE_STRIP, 0, pathVertexCount);
 
     // Unbind the path VAO
     glBindVertexArray(0);
 }
 
 // Function to draw the keyframes
-void VirtualCameraChannel::drawKeyframes(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& keyframePositions) {
-    // Bind and upload keyframe positions to the VBO
-    glBindVertexArray(keyframeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, keyframeVBO);
-    glBufferData(GL_ARRAY_BUFFER, keyframePositions.size() * sizeof(glm::vec3), keyframePositions.data(), GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+void VirtualCameraChannel::drawKeyframes(const glm::mat4& view, const glm::mat4& projection) {
+    if (keyframeVertexCount == 0) return;
 
     // Enable point size
     glEnable(GL_PROGRAM_POINT_SIZE);
@@ -203,59 +287,52 @@ void VirtualCameraChannel::drawKeyframes(const glm::mat4& view, const glm::mat4&
     glUniformMatrix4fv(glGetUniformLocation(keyframeShader->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
     // Draw the keyframes as points
-    glDrawArrays(GL_POINTS, 0, keyframePositions.size());
+    glBindVertexArray(keyframeVAO);
+    glDrawArrays(GL_POINTS, 0, keyframeVertexCount);
 
     // Unbind the keyframe VAO and shader program
     glBindVertexArray(0);
     glUseProgram(0);
 }
 
-void VirtualCameraChannel::drawSpeedCurve(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& speedCurvePositions) {
-    if (speedCurvePositions.empty()) return;
+// Rebuilds the axes and curve vertices from the speed profile; only after the channel changed
+void VirtualCameraChannel::uploadSpeedCurve() {
+    std::vector<glm::vec3> vertices;
+    if (speedProfile.size() >= 2) {
+        float maxSpeed = 0.0f;
+        for (const glm::vec2& sample : speedProfile) {
+            maxSpeed = std::max(maxSpeed, sample.y);
+        }
+        float yScaleFactor = maxSpeed > 0.0f ? 2.0f / maxSpeed : 1.0f; // Peak speed drawn 2 units high
 
-    if (!speedCurveDrawn) {
-        speedCurveDrawn = true;
-        drawnSpeedCurve.insert(drawnSpeedCurve.end(), speedCurvePositions.begin(), speedCurvePositions.end());
-    }
+        // x axis along time, y axis along speed, starting at the first sample
+        glm::vec3 start(speedProfile.front().x, 0.0f, 5.0f);
+        vertices.push_back(start);
+        vertices.push_back(glm::vec3(speedProfile.back().x, 0.0f, 5.0f));
+        vertices.push_back(start);
+        vertices.push_back(start + glm::vec3(0.0f, 2.0f, 0.0f));
 
-    // Generate and bind VAO and VBO if they are not generated yet
-    if (!glIsVertexArray(speedCurveVAO)) {
-        glGenVertexArrays(1, &speedCurveVAO);
-    }
-    if (!glIsBuffer(speedCurveVBO)) {
-        glGenBuffers(1, &speedCurveVBO);
-    }
-
-    // Create vertices for x and y axes
-    std::vector<glm::vec3> axisVertices;
-    glm::vec3 start = drawnSpeedCurve[0];
-    axisVertices.push_back(start);               // Start of x-axis
-    axisVertices.push_back(start + glm::vec3(drawnSpeedCurve.size() * 0.3f, 0.0f, 0.0f)); // End of x-axis
-    axisVertices.push_back(start);               // Start of y-axis
-    axisVertices.push_back(start + glm::vec3(0.0f, drawnSpeedCurve.size() * 0.05f, 0.0f)); // End of y-axis
-
-    // Apply a scaling factor to the y-values for better visualization
-    float yScaleFactor = 20.0f; // Adjust this value as needed for clarity
-
-    // Create vertices for the speed curve with scaled y-values
-    std::vector<glm::vec3> scaledSpeedCurve;
-    for (const auto& point : drawnSpeedCurve) {
-        glm::vec3 scaledPoint = point;
-        scaledPoint.y *= yScaleFactor;
-        scaledSpeedCurve.push_back(scaledPoint);
+        for (const glm::vec2& sample : speedProfile) {
+            vertices.push_back(glm::vec3(sample.x, sample.y * yScaleFactor, 5.0f));
+        }
     }
 
-    // Combine axis vertices and scaled speed curve positions
-    std::vector<glm::vec3> combinedVertices = axisVertices;
-    combinedVertices.insert(combinedVertices.end(), scaledSpeedCurve.begin(), scaledSpeedCurve.end());
-
-    // Bind and upload combined vertices to the VBO
     glBindVertexArray(speedCurveVAO);
     glBindBuffer(GL_ARRAY_BUFFER, speedCurveVBO);
-    glBufferData(GL_ARRAY_BUFFER, combinedVertices.size() * sizeof(glm::vec3), combinedVertices.data(), GL_STATIC_DRAW);
-
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glBindVertexArray(0);
+
+    speedCurveVertexCount = static_cast<int>(vertices.size());
+    uploadedSpeedCurveVersion = getVersion();
+}
+
+void VirtualCameraChannel::drawSpeedCurve(const glm::mat4& view, const glm::mat4& projection) {
+    if (uploadedSpeedCurveVersion != getVersion()) {
+        uploadSpeedCurve();
+    }
+    if (speedCurveVertexCount < 4) return;
 
     // Use the speed curve shader program
     glUseProgram(speedCurveShader->ID);
@@ -264,43 +341,60 @@ void VirtualCameraChannel::drawSpeedCurve(const glm::mat4& view, const glm::mat4
     glUniformMatrix4fv(glGetUniformLocation(speedCurveShader->ID, "view"), 1, GL_FALSE, glm::value_ptr(view));
     glUniformMatrix4fv(glGetUniformLocation(speedCurveShader->ID, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
-    // Draw the axes
-    glDrawArrays(GL_LINES, 0, axisVertices.size());
-
-    // Draw the speed curve
-    glDrawArrays(GL_LINE_STRIP, axisVertices.size(), scaledSpeedCurve.size());
-
-    // Unbind the VAO
+    glBindVertexArray(speedCurveVAO);
+    glDrawArrays(GL_LINES, 0, 4); // Axes
+    glDrawArrays(GL_LINE_STRIP, 4, speedCurveVertexCount - 4); // Speed curve
     glBindVertexArray(0);
 }
 
 
-void VirtualCameraChannel::traversePath() {
-    if (interpolatedKeyFrames.empty()) return;
+// Camera pose along the traversal path; no camera before startTraversal() or past the end
+ChannelState VirtualCameraChannel::evaluate(float time) const {
+    if (!traversalStarted) return ChannelState();
 
-    Camera& camera = Camera::getInstance();
-    glm::vec3 cubePosition(0.0f, 0.0f, 0.0f);
+    CameraPath::Cursor lookup; // Stateless: evaluate() may run for any time, on any thread
+    return evaluatePose(time, lookup, false);
+}
 
-    if (currentTime >= interpolatedKeyFrames.back().timestamp) {
-        traversalComplete = true;
-        isTraversalInProgress = false;
-        return;
+ChannelState VirtualCameraChannel::evaluatePose(float time, CameraPath::Cursor& cursor, bool liveTarget) const {
+    ChannelState state;
+    if (path.isEmpty() || time >= path.getEndTime()) {
+        return state;
     }
 
-    for (const auto& keyFrame : interpolatedKeyFrames) {
-        if (keyFrame.timestamp > currentTime) {
-            camera.Position = keyFrame.position;
+    glm::quat orientation;
+    path.poseAt(time, cursor, state.cameraPosition, orientation);
+    state.hasCamera = true;
 
-            // Make the camera look at the cube
-            camera.Front = glm::normalize(cubePosition - camera.Position);
-            camera.Right = glm::normalize(glm::cross(camera.Front, camera.WorldUp));
-            camera.Up = glm::normalize(glm::cross(camera.Right, camera.Front));
+    if (aim == CameraAim::KEYFRAMED) {
+        state.cameraFront = glm::normalize(orientation * glm::vec3(0.0f, 0.0f, -1.0f));
+        return state;
+    }
 
-            break;
+    glm::vec3 target = lookAtPoint;
+    auto channel = lookAtChannel.lock();
+    if (aim == CameraAim::LOOK_AT_CHANNEL && channel) {
+        // Live playback reads the target's pose of this step (it updated first, see setLookAtChannel)
+        float animationTime = time / timeScale + timeOffset;
+        ChannelState targetState = liveTarget ? channel->captureState() : channel->evaluate(channel->toLocalTime(animationTime));
+        if (targetState.hasTransform) {
+            target = targetState.position;
         }
     }
 
-    currentTime += 0.016f; // Simulate time progression, equivalent to 60 FPS
+    glm::vec3 toTarget = target - state.cameraPosition;
+    if (glm::length(toTarget) > 1e-6f) {
+        state.cameraFront = glm::normalize(toTarget);
+    }
+    return state;
+}
+
+ChannelState VirtualCameraChannel::captureState() const {
+    ChannelState state;
+    state.hasCamera = isTraversalInProgress; // Leave the user's camera alone otherwise
+    state.cameraPosition = cameraPosition;
+    state.cameraFront = cameraFront;
+    return state;
 }
 
 void VirtualCameraChannel::printKeyframesWithInterpolations(std::vector<KeyFrame> interpolatedKeyFrames) {
@@ -328,39 +422,12 @@ void VirtualCameraChannel::printKeyframesWithInterpolations(std::vector<KeyFrame
 }
 
 std::vector<KeyFrame> VirtualCameraChannel::interpolateKeyFrames() const {
-    std::vector<KeyFrame> interpolatedKeyFrames;
-
-    if (keyFrames.empty()) return interpolatedKeyFrames;
-
-    for (size_t i = 0; i < keyFrames.size() - 1; ++i) {
-        if (i == 0 || i == keyFrames.size() - 1) {
-			interpolatedKeyFrames.push_back(keyFrames[i]);
-		}
-        float startTime = keyFrames[i].timestamp;
-        float endTime = keyFrames[i + 1].timestamp;
-        float interval = (endTime - startTime) / frameRate;
-
-        for (int j = 1; j < frameRate; ++j) {
-            float currentTime = startTime + j * interval;
-            glm::vec3 interpolatedPosition = interpolatePosition(currentTime);
-            glm::quat interpolatedOrientation = interpolateOrientation(currentTime);
-            glm::vec3 interpolatedScale = interpolateScale(currentTime);
-
-            interpolatedKeyFrames.emplace_back(currentTime, interpolatedPosition, interpolatedOrientation, interpolatedScale);
-        }
-    }
-
-    interpolatedKeyFrames.push_back(keyFrames.back());
-    return interpolatedKeyFrames;
+    TRACE_FUNCTION();
+    return path.sample(frameRate);
 }
 
 void VirtualCameraChannel::initPathRendering() {
-    // Check if OpenGL context is initialized
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD or OpenGL context is not available." << std::endl;
-        return;
-    }
-
+    // GL functions are loaded once by whoever created the context (window or headless)
     // Initialize VAO and VBO for path
     glGenVertexArrays(1, &pathVAO);
     glGenBuffers(1, &pathVBO);
@@ -373,10 +440,14 @@ void VirtualCameraChannel::initPathRendering() {
     glGenVertexArrays(1, &speedCurveVAO);
     glGenBuffers(1, &speedCurveVBO);
 
-    // Initialize the shaders
-    pathShader = new ShaderD("../Shaders/path.vs", "../Shaders/path.fs");
-    keyframeShader = new ShaderD("../Shaders/keyframe.vs", "../Shaders/keyframe.fs");
-    speedCurveShader = new ShaderD("../Shaders/speed_curve.vs", "../Shaders/speed_curve.fs");
+    // Initialize the shaders, unless this is a clone that got the original's
+    if (!pathShader) {
+        pathShader = std::make_shared<ShaderD>("../Shaders/path.vs", "../Shaders/path.fs");
+        keyframeShader = std::make_shared<ShaderD>("../Shaders/keyframe.vs", "../Shaders/keyframe.fs");
+        speedCurveShader = std::make_shared<ShaderD>("../Shaders/speed_curve.vs", "../Shaders/speed_curve.fs");
+    }
+
+    splinePath = std::make_unique<SplinePath>();
 
     isInitialized = true;
 }
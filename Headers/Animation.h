@@ -5,28 +5,148 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "Channel.h"
 
+enum class PlaybackMode {
+    ONCE,      // Stop at the end
+    LOOP,      // Jump back to the start
+    PING_PONG  // Reverse direction at either end
+};
+
+// The changes of an editing copy of a scene since its previous commit, for the animation
+// that plays it (see Animation::commit and Animation::publish). Holds only what changed,
+// and the channels in it are never edited again: further edits work on fresh clones.
+struct SceneCommit {
+    uint64_t version = 0;                            // Increases with every commit
+    std::vector<std::shared_ptr<Channel>> channels;  // Added or edited, they replace the channel with their handle
+    std::vector<ChannelHandle> removed;
+    std::vector<ChannelHandle> order;                // Complete channel order, only when it changed otherwise than by appending
+    std::shared_ptr<const SceneCommit> previous;     // Older commit published before this one was applied
+};
+
 class Animation {
 public:
     Animation(const std::string& name);
 
+    // Channels are looked up through hashed indices, by handle (stable) or by name
+    // (the oldest channel wins if several share a name)
     void addChannel(std::shared_ptr<Channel> channel);
+    bool removeChannel(ChannelHandle handle);
     void removeChannel(const std::string& channelName);
+    std::shared_ptr<Channel> getChannel(ChannelHandle handle) const;
     std::shared_ptr<Channel> getChannel(const std::string& channelName) const;
+    size_t getChannelIndex(ChannelHandle handle) const; // Position in getChannels(), or its size if absent
+    bool renameChannel(ChannelHandle handle, const std::string& newName);
     void updateChannelName(const std::string& oldName, const std::string& newName);
+
+    // Update ordering between channels of this animation; refuses dependencies that would close a cycle
+    bool addDependency(ChannelHandle channel, ChannelHandle dependency);
+    void removeDependency(ChannelHandle channel, ChannelHandle dependency);
+
+    // Copy-on-write editing. The editor keeps its own Animation and edits channels only through
+    // editChannel(), which replaces a channel that was committed by a private clone first, so the
+    // playing animation never sees a half-done edit. commit() collects what changed since the
+    // previous commit; replaceAll makes the player drop every channel the commit does not list.
+    std::shared_ptr<Channel> editChannel(ChannelHandle handle);
+    std::shared_ptr<SceneCommit> commit(bool replaceAll = false);
+
+    // Playing side. publish() may be called from any thread; applyPublished() takes over every
+    // commit published since the last call, in order, and must run between updates on the thread
+    // that updates the animation. The channel references it lets go of are handed back, so the caller
+    // can release them on the GL thread.
+    void publish(std::shared_ptr<SceneCommit> commit);
+    bool applyPublished(std::vector<std::shared_ptr<Channel>>& released);
+    uint64_t getAppliedVersion() const { return appliedVersion; }
+    // Channel updates run in dependency order; with parallel update enabled, independent
+    // channels are updated concurrently on the JobSystem while this thread helps out
     void update(float deltaTime);
     void render(const glm::mat4& view, const glm::mat4& projection);
+
+    // Split update/render path: capture every channel's state after update(), then
+    // apply the camera and draw from that snapshot, possibly on another thread
+    void captureSnapshot(FrameSnapshot& snapshot) const;
+    void applyCamera(const FrameSnapshot& snapshot) const;
+    void renderSnapshot(const FrameSnapshot& snapshot, const glm::mat4& view, const glm::mat4& projection);
+
+    // Every channel's state at an arbitrary time, without advancing or modifying anything.
+    // Const and thread-safe, so frames can be evaluated out of order or in parallel.
+    void evaluate(float time, FrameSnapshot& snapshot) const;
+    float getElapsedTime() const { return elapsedTime; } // Sum of all update() steps
+
+    // Fixed-step clock: advance() runs as many update(getFixedStep()) calls as the elapsed
+    // time allows, so every channel sees the same deterministic steps whatever the frame rate.
+    // captureInterpolated() then blends the last two steps by the leftover time for rendering.
+    void advance(float frameDeltaTime);
+    // Same without the catch-up limit advance() applies to stalls: every second of deltaTime is
+    // simulated, for offline rendering where frames may be far apart (e.g. below 4 fps)
+    void advanceExact(float deltaTime);
+    void captureInterpolated(FrameSnapshot& snapshot) const;
+    void setFixedStepRate(float hz);
+    float getFixedStep() const { return fixedStep; }
+    float getFixedStepRate() const { return 1.0f / fixedStep; }
+    void resetClock();
     const std::string& getName() const;
     const std::vector<std::shared_ptr<Channel>>& getChannels() const;
     void swapChannels(size_t index1, size_t index2);
 
     void setSkyboxView(const glm::mat4& view) { skyboxView = view; }
 
+    // Transport. update() moves the playhead by deltaTime * speed and every channel follows it
+    // at its own offset and scale; seek() is applied at the next update through Channel::seek
+    void play() { playing = true; }
+    void pause() { playing = false; }
+    bool isPlaying() const { return playing; }
+    void seek(float time);
+    float getPlayhead() const { return playhead; }
+    void setPlaybackMode(PlaybackMode mode) { playbackMode = mode; }
+    PlaybackMode getPlaybackMode() const { return playbackMode; }
+    void setPlaybackSpeed(float speed) { playbackSpeed = speed; }
+    float getPlaybackSpeed() const { return playbackSpeed; }
+    float getDuration() const; // End of the last channel, in animation time
+
+    void setParallelUpdate(bool enabled) { parallelUpdate = enabled; }
+    bool isParallelUpdate() const { return parallelUpdate; }
+
 private:
     std::string name;
     std::vector<std::shared_ptr<Channel>> channels;
+    std::unordered_map<ChannelHandle, size_t> channelIndices;                   // Handle -> position in channels
+    std::unordered_map<std::string, std::vector<ChannelHandle>> channelsByName; // Sorted by handle
+
+    std::unordered_set<ChannelHandle> uncommittedChannels; // Added or cloned since the last commit, safe to edit
+    std::vector<ChannelHandle> removedSinceCommit;
+    bool orderChangedSinceCommit = false;
+    std::shared_ptr<SceneCommit> publishedCommit; // Newest commit not applied yet (atomic access only)
+    uint64_t appliedVersion = 0;
     glm::mat4 skyboxView;
+    bool parallelUpdate = true;
+    unsigned long long frameCounter = 0;
+    float elapsedTime = 0.0f;
+
+    float fixedStep = 1.0f / 60.0f;
+    float accumulator = 0.0f;
+    float maxCatchUp = 0.25f;     // Seconds of backlog simulated at most per frame; the rest is dropped
+    FrameSnapshot previousStep;   // The two most recent fixed steps, for interpolation
+    FrameSnapshot currentStep;
+
+    bool playing = true;
+    PlaybackMode playbackMode = PlaybackMode::ONCE;
+    float playbackSpeed = 1.0f;
+    float playhead = 0.0f;
+    float playDirection = 1.0f;  // -1 on the way back in ping-pong mode
+    bool seekPending = true;     // Channels start out synced to the playhead
+
+    bool advancePlayhead(float deltaTime);
+    void runFixedSteps(); // Consumes the accumulator in fixed steps
+    void indexName(const std::string& channelName, ChannelHandle handle);
+    void unindexName(const std::string& channelName, ChannelHandle handle);
+    void eraseChannel(size_t index);
+    void rebuildIndices();
+    void resolveReferences() const;
+    void applyCommit(const SceneCommit& commit, std::vector<std::shared_ptr<Channel>>& released);
+    bool buildUpdateOrder(std::vector<size_t>& order, std::vector<std::vector<size_t>>& dependents, std::vector<int>& dependencyCount) const;
 };
 
 #endif // ANIMATION_H
@@ -8,9 +8,10 @@
 #include <GLFW/glfw3.h>
 #include "Channel.h"
 #include "ShaderD.h"
+#include "TextureCache.h"
 #include <glm/gtc/type_ptr.hpp>
-#include <stb_image.h> // For loading images
 #include <iostream>
+#include <memory>
 
 class BackgroundChannel : public Channel {
 public:
@@ -21,16 +22,23 @@ public:
     void loadSkybox(const std::vector<std::string>& faces);
     virtual void update(float deltaTime) override;
     virtual void render(const glm::mat4& view, const glm::mat4& projection) override;  // Update render function
+    std::shared_ptr<Channel> clone() const override;
+
+    void writeSceneSettings(std::ostream& out) const override;
+    void readSceneSetting(const std::string& key, const std::string& value) override;
 
 private:
     void setupBackground();
 
     GLuint backgroundVAO = 0;
     GLuint backgroundVBO = 0;
-    GLuint textureID = 0;
-    GLuint skyboxTextureID;
-    ShaderD* backgroundShader;
+    std::shared_ptr<CachedTexture> texture;       // Shared through the TextureCache
+    std::shared_ptr<CachedTexture> skyboxTexture; // Released when replaced or on destruction
+    std::shared_ptr<ShaderD> backgroundShader; // Shared with clones
     bool setupCompleted;
+
+    std::string texturePath;             // Kept for scene files
+    std::vector<std::string> skyboxFaces;
 };
 
 #endif // BACKGROUND_CHANNEL_H
@@ -0,0 +1,12 @@
+#pragma once
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// Micro-benchmarks of the anim core kernels (interpolation, segment search, FFD, keyframe parsing,
+// skeleton evaluation). Only depends on Core/, so no GL context is needed.
+//   --bench [--bench-filter <substring>] [--bench-out <file.json>] [--bench-min-time <seconds>]
+// Results are printed as a table and, with --bench-out, written as JSON using the field names
+// of Google Benchmark's output so its compare tooling can diff two runs.
+int runBenchmarks(int argc, char** argv);
+
+#endif // BENCHMARKS_H
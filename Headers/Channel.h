@@ -2,9 +2,13 @@
 #ifndef CHANNEL_H
 #define CHANNEL_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
-#include "KeyFrame.h"
+#include "Core/KeyFrame.h"
+#include "Core/KeyFrameTracks.h"
+#include "ChannelState.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -16,43 +20,128 @@ enum ChannelType {
     CHARACTER_ANIMATION
 };
 
+class Animation;
+
+// Stable identity of a channel: its id, unique per process and never reused,
+// so it survives renames, reordering and duplicate names (0 = no channel)
+using ChannelHandle = uint64_t;
+const ChannelHandle INVALID_CHANNEL_HANDLE = 0;
+
 // Base class for different animation channels
 class Channel {
 public:
-    Channel(const std::string& name, ChannelType type) : name(name), channelType(type) {}
+    Channel(const std::string& name, ChannelType type);
     virtual ~Channel() {}
 
     // Virtual methods to be implemented by derived classes
+    // update() is CPU-only and may run on a worker thread in parallel with other channels;
+    // all GL work (uploads included) belongs in render(), which runs on the render thread
     virtual void update(float deltaTime) = 0;
     virtual void render(const glm::mat4& view, const glm::mat4& projection) = 0;
 
+    // Jump straight to a channel-local time (seek, loop wrap); update() continues from there
+    virtual void seek(float localTime) {}
+
+    // Snapshot of what update() produced, taken on the thread that ran update()
+    virtual ChannelState captureState() const { return ChannelState(); }
+    // State at an arbitrary animation time, without touching the channel (safe to call from
+    // several threads at once). Channels whose look does not depend on time return captureState()
+    virtual ChannelState evaluate(float time) const { return captureState(); }
+    // Draw a previously captured state instead of the live one (render thread)
+    virtual void renderState(const ChannelState& state, const glm::mat4& view, const glm::mat4& projection) { render(view, projection); }
+
     // Common methods
     const std::string& getName() const { return name; }
-    void setName(const std::string& newName) { name = newName; }
+    ChannelHandle getHandle() const { return id; }
     ChannelType getType() const { return channelType; }
     std::string getTypeString() const; // Declaration of the function
     
-    void addKeyFrame(const KeyFrame& keyFrame) { keyFrames.push_back(keyFrame); }
+    void addKeyFrame(const KeyFrame& keyFrame) { keyFrames.push_back(keyFrame); markChanged(); }
     
 
     void swapKeyFrames(size_t index1, size_t index2);
     void updateKeyFrame(size_t index, const KeyFrame& keyFrame);
     void removeKeyFrame(size_t index);
 
-    void setFrameRate(float frameRate) { this->frameRate = frameRate; }
+    void setFrameRate(float frameRate) { this->frameRate = frameRate; markChanged(); }
+    float getFrameRate() const { return frameRate; }
     const std::vector<KeyFrame>& getKeyFrames() const { return keyFrames; }
-    std::vector<KeyFrame>& getKeyFrames() { return keyFrames; }
+    std::vector<KeyFrame>& getKeyFrames() { return keyFrames; } // Call markChanged() after editing through this
+    // The keyframes per property, as evaluation reads them; rebuilt by markChanged()
+    const KeyFrameTracks& getTracks() const { return tracks; }
+
+    // Identity and content version for caching evaluated states (see FrameCache).
+    // The version changes whenever anything evaluate() depends on changes; versions are
+    // unique across channels, so a clone that is edited never reuses one of its original
+    uint64_t getId() const { return id; }
+    uint64_t getVersion() const { return version; }
+    void markChanged();
+
+    // Copy of the channel under the same handle and version, for copy-on-write editing
+    // (see Animation::editChannel). GL objects are not shared; the copy creates its own
+    // on first render. Call on the thread that owns the GL context.
+    virtual std::shared_ptr<Channel> clone() const = 0;
 
     bool isActive = true;
 
+    // Placement on the animation timeline: local time = (animation time - offset) * scale
+    void setTimeOffset(float offset) { timeOffset = offset; }
+    float getTimeOffset() const { return timeOffset; }
+    void setTimeScale(float scale) { timeScale = scale; }
+    float getTimeScale() const { return timeScale; }
+    float toLocalTime(float animationTime) const { return (animationTime - timeOffset) * timeScale; }
+    float getEndTime() const; // Animation time of the last keyframe
+
     void loadKeyFramesFromFile(const std::string& filePath);
+    void loadKeyFrames(std::istream& in);        // Same text format as loadKeyFramesFromFile
+    void saveKeyFrames(std::ostream& out) const; // Readable by loadKeyFrames
+
+    // Scene files: each channel writes the assets it was set up with as "Key: value" lines
+    // and gets them back through readSceneSetting when the scene is loaded (needs a GL context)
+    virtual void writeSceneSettings(std::ostream& out) const {}
+    virtual void readSceneSetting(const std::string& key, const std::string& value) {}
+
+    // Update ordering: this channel's update only starts once every dependency's update finished
+    // (e.g. anything that reads the camera should depend on the virtual camera channel).
+    // Dependencies are handles resolved by the owning Animation; Animation::addDependency refuses cycles
+    void addDependency(ChannelHandle handle);
+    void removeDependency(ChannelHandle handle);
+    bool dependsOn(ChannelHandle handle) const;
+    const std::vector<ChannelHandle>& getDependencies() const { return dependencies; }
+
+    // For channels that keep handles to other channels and cache what they resolve to.
+    // An editable Animation copies every channel that refers to a channel it replaces or
+    // removes and resolves the copy, so committed channels never need resolving again
+    virtual bool refersTo(ChannelHandle handle) const { return false; }
+    virtual void resolveReferences(const Animation& animation) {}
 protected:
     std::string name;
     ChannelType channelType;
     std::vector<KeyFrame> keyFrames;  // Store key frames
+    KeyFrameTracks tracks;            // Structure-of-arrays copy of keyFrames
     float frameRate = 24.0f; // Default frame rate
+    float timeOffset = 0.0f;
+    float timeScale = 1.0f;
 
     bool animationFinished = false;
+
+    // evaluate() through the FrameCache
+    ChannelState evaluateCached(float localTime) const;
+
+    // Called by markChanged(), for channels that derive data from their keyframes
+    virtual void onChanged() {}
+
+    // For clone(): everything the base class holds, identity included
+    void copyChannelState(const Channel& source);
+
+private:
+    friend class Animation;
+    // Only through Animation::renameChannel, which keeps its name index in sync
+    void setName(const std::string& newName) { name = newName; }
+
+    std::vector<ChannelHandle> dependencies;
+    uint64_t id;
+    uint64_t version = 0;
 };
 
 #endif // CHANNEL_H
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef CHANNEL_STATE_H
+#define CHANNEL_STATE_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include "Core/FFD.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <memory>
+#include <vector>
+
+class Channel;
+
+
+// Result of evaluating one channel for one frame. Once captured it is never modified,
+// so the render thread can draw it while the simulation already works on the next frame.
+struct ChannelState {
+    bool hasTransform = false;
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    bool hasCamera = false; // Set while the channel drives the camera
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    std::shared_ptr<const DeformedPositions> deformedPositions; // nullptr draws the rest pose
+};
+
+// Every channel's state for one simulated frame
+struct FrameSnapshot {
+    unsigned long long frameIndex = 0;
+    float time = 0.0f;                               // Animation time the states belong to
+    std::vector<std::shared_ptr<Channel>> channels; // Keeps the channels alive while the frame is in flight
+    std::vector<ChannelState> states;               // Parallel to channels
+};
+
+#endif // CHANNEL_STATE_H
@@ -2,9 +2,6 @@
 #ifndef CHARACTERANIMATIONCHANNEL_H
 #define CHARACTERANIMATIONCHANNEL_H
 
-#define NOMINMAX
-#include <Windows.h>
-
 #include "Channel.h"
 #include <glm/gtx/string_cast.hpp>
 
@@ -12,6 +9,7 @@
 #include <fstream>
 
 #include "StickFigure.h"
+#include <memory>
 
 
 class CharacterAnimationChannel : public Channel {
@@ -19,6 +17,7 @@ public:
     CharacterAnimationChannel(const std::string& name);
     void update(float deltaTime);
     void render(const glm::mat4& view, const glm::mat4& projection);
+    std::shared_ptr<Channel> clone() const override;
 
 private:
     glm::vec3 interpolatedPosition;
@@ -26,7 +25,7 @@ private:
     glm::vec3 interpolatedScale;
     glm::mat4 getModelMatrix() const;
 
-    StickFigure* character;
+    std::shared_ptr<StickFigure> character; // Drawn as is, so clones share it
 };
 
 #endif // CHARACTERANIMATIONCHANNEL_H
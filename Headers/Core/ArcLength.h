@@ -0,0 +1,35 @@
+#pragma once
+#ifndef CORE_ARC_LENGTH_H
+#define CORE_ARC_LENGTH_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Integral of f over [a, b] by 5-point Gauss-Legendre, halving the interval until both halves
+// agree with the whole to within tolerance (or maxDepth halvings)
+float integrateGaussLegendre(const std::function<float(float)>& f, float a, float b, float tolerance, int maxDepth = 12);
+
+// Cumulative arc length of a curve over its parameter range [0, 1], built once from the curve's
+// speed |dC/du| and then inverted per sample with a binary search.
+class ArcLengthTable {
+public:
+    void build(const std::function<float(float)>& speed, int intervals = 128, float tolerance = 1e-5f);
+    void clear();
+
+    bool isEmpty() const { return distances.empty(); }
+    float getLength() const { return distances.empty() ? 0.0f : distances.back(); }
+
+    float distanceAtParameter(float u) const;
+    float parameterAtDistance(float distance) const;
+    // Same, but starts looking at the interval in cursor and leaves the one it found there.
+    // Amortised O(1) while successive distances stay close, as they do during playback.
+    float parameterAtDistance(float distance, size_t& cursor) const;
+
+private:
+    float parameterInInterval(size_t lower, float distance) const;
+
+    std::vector<float> distances; // distances[i] = length from u = 0 to u = i / intervals
+};
+
+#endif // CORE_ARC_LENGTH_H
@@ -0,0 +1,66 @@
+#pragma once
+#ifndef CORE_CAMERA_PATH_H
+#define CORE_CAMERA_PATH_H
+
+#include "ArcLength.h"
+#include "KeyFrame.h"
+#include "PathTessellation.h"
+#include "SpeedCurve.h"
+#include "SquadTrack.h"
+
+#include <vector>
+
+// Camera path through keyframes: one Bezier curve over all keyframe positions, traversed over the
+// keyframes' time span, with a SQUAD spline through their orientations. Time maps to a fraction of
+// the path length through the speed curve, and length maps to the curve parameter through an
+// arc-length table, so the speed does not depend on how the keyframes are spaced.
+// build() again whenever the keyframes change.
+class CameraPath {
+public:
+    // Where the last lookup ended; lets playback find the next sample without searching
+    struct Cursor {
+        size_t arcInterval = 0;
+        size_t keySegment = 0;
+    };
+
+    void build(const std::vector<KeyFrame>& keyFrames);
+
+    void setSpeedCurve(const SpeedCurve& curve) { speedCurve = curve; }
+    const SpeedCurve& getSpeedCurve() const { return speedCurve; }
+
+    bool isEmpty() const { return keyFrames.empty(); }
+    const std::vector<glm::vec3>& getControlPoints() const { return positions; }
+    float getLength() const { return arcLength.getLength(); }
+    float getStartTime() const { return keyFrames.empty() ? 0.0f : keyFrames.front().timestamp; }
+    float getEndTime() const { return keyFrames.empty() ? 0.0f : keyFrames.back().timestamp; }
+
+    float parameterAt(float time) const; // Curve parameter in [0, 1]
+    float parameterAt(float time, Cursor& cursor) const;
+    glm::vec3 positionAt(float time) const;
+    glm::quat orientationAt(float time) const;
+    glm::vec3 scaleAt(float time) const; // Piecewise linear between keyframes
+    void poseAt(float time, Cursor& cursor, glm::vec3& position, glm::quat& orientation) const;
+    float speedAt(float time) const;     // World units per second, from the speed curve's derivative
+
+    // (time, speed) at sampleCount evenly spaced times over the path
+    std::vector<glm::vec2> speedProfile(int sampleCount) const;
+
+    // The path sampled frameRate times per keyframe interval, keyframes included
+    std::vector<KeyFrame> sample(float frameRate) const;
+
+    // Polyline of the path's shape for drawing, dense only where the curve bends
+    std::vector<glm::vec3> tessellate(const PathTolerance& tolerance) const;
+
+private:
+    float distanceAt(float time) const; // Along the path, through the speed curve
+    // Keyframe interval containing time, walking from cursor.keySegment
+    void findKeySegment(float time, Cursor& cursor, float& t) const;
+
+    std::vector<KeyFrame> keyFrames;
+    std::vector<glm::vec3> positions; // Control points
+    SquadTrack rotations; // Orientation keys, interpolated over keyframe time
+    ArcLengthTable arcLength;
+    SpeedCurve speedCurve;
+};
+
+#endif // CORE_CAMERA_PATH_H
@@ -0,0 +1,17 @@
+#pragma once
+#ifndef CORE_FFD_H
+#define CORE_FFD_H
+
+#include "KeyFrame.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// Deformed vertex positions of a model, one array per mesh
+using DeformedPositions = std::vector<std::vector<glm::vec3>>;
+
+// Free-form deformation of rest positions (one array per mesh) by inverse-distance weighted
+// control point displacements. The result keeps the rest pose's center of mass.
+void deformFFD(const std::vector<const std::vector<glm::vec3>*>& restMeshes, const std::vector<FFDControlPoint>& controlPoints, DeformedPositions& deformed);
+
+#endif // CORE_FFD_H
@@ -0,0 +1,18 @@
+#pragma once
+#ifndef CORE_INTERPOLATION_H
+#define CORE_INTERPOLATION_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+// De Casteljau evaluation of the Bezier curve through the whole control polygon
+glm::vec3 bezierInterpolate(const std::vector<glm::vec3>& points, float t);
+glm::quat bezierInterpolate(const std::vector<glm::quat>& points, float t); // slerp instead of lerp
+glm::vec3 bezierDerivative(const std::vector<glm::vec3>& points, float t);  // dC/dt
+
+float easeInOutCubic(float t);
+
+#endif // CORE_INTERPOLATION_H
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef CORE_KEYFRAME_IO_H
+#define CORE_KEYFRAME_IO_H
+
+#include "KeyFrame.h"
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Text keyframe format shared by keyframe files and scene files:
+//   KeyFrame 0
+//   Timestamp: 0
+//   Position: (x, y, z)
+//   Orientation: (x, y, z, w)
+//   Scale: (x, y, z)
+//   Control Point 0: Position (x, y, z), Original Position (x, y, z), Weight w
+std::vector<KeyFrame> parseKeyFrames(std::istream& in);
+void writeKeyFrames(std::ostream& out, const std::vector<KeyFrame>& keyFrames);
+
+#endif // CORE_KEYFRAME_IO_H
@@ -0,0 +1,14 @@
+#pragma once
+#ifndef CORE_KEYFRAME_TRACK_H
+#define CORE_KEYFRAME_TRACK_H
+
+#include "KeyFrame.h"
+
+#include <cstddef>
+#include <vector>
+
+// Keyframe segment containing time: keyFrames[index] to keyFrames[index + 1] at blend factor t.
+// Times before the first keyframe clamp to it; false past the last one or with fewer than two keys.
+bool findKeyFrameSegment(const std::vector<KeyFrame>& keyFrames, float time, size_t& index, float& t);
+
+#endif // CORE_KEYFRAME_TRACK_H
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef CORE_KEYFRAME_TRACKS_H
+#define CORE_KEYFRAME_TRACKS_H
+
+#include "KeyFrame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Keys of one property: times and values in separate contiguous arrays, sorted by time
+template <typename T>
+struct PropertyTrack {
+    std::vector<float> times;
+    std::vector<T> values;
+
+    bool isEmpty() const { return times.empty(); }
+    size_t size() const { return times.size(); }
+
+    void clear() { times.clear(); values.clear(); }
+    void setKey(float time, const T& value); // Replaces a key at the same time
+
+    // Keys around time: values[index] and values[index + 1] at blend factor t.
+    // False with index at the nearest key before the first key, past the last one, or with one key.
+    bool findSegment(float time, size_t& index, float& t) const;
+};
+
+// A key's control points in KeyFrameTracks::controlPoints
+struct ControlPointSpan {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+
+// Structure-of-arrays form of a channel's keyframes, for sampling. Every property has its own key
+// times: build() keeps only the keys where a property changes, so a channel that only animates
+// rotation has a single position and scale key. FFD control points of all keys share one flat
+// buffer. Channels keep editing std::vector<KeyFrame>; the tracks are rebuilt from it on change.
+class KeyFrameTracks {
+public:
+    PropertyTrack<glm::vec3> position;
+    PropertyTrack<glm::quat> rotation;
+    PropertyTrack<glm::vec3> scale;
+    PropertyTrack<ControlPointSpan> ffd;
+    std::vector<FFDControlPoint> controlPoints;
+
+    void build(const std::vector<KeyFrame>& keyFrames);
+    void clear();
+
+    float getStartTime() const { return startTime; }
+    float getEndTime() const { return endTime; }
+    size_t getByteSize() const;
+
+    // Linear (slerp for rotation) between the property's keys, clamped to its first and last key
+    glm::vec3 samplePosition(float time) const;
+    glm::quat sampleRotation(float time) const;
+    glm::vec3 sampleScale(float time) const;
+    // Control point positions are interpolated, original positions and weights come from the earlier key
+    void sampleControlPoints(float time, std::vector<FFDControlPoint>& out) const;
+
+private:
+    float startTime = 0.0f;
+    float endTime = 0.0f;
+};
+
+template <typename T>
+void PropertyTrack<T>::setKey(float time, const T& value) {
+    size_t index = 0;
+    while (index < times.size() && times[index] < time) ++index;
+    if (index < times.size() && times[index] == time) {
+        values[index] = value;
+        return;
+    }
+    times.insert(times.begin() + index, time);
+    values.insert(values.begin() + index, value);
+}
+
+template <typename T>
+bool PropertyTrack<T>::findSegment(float time, size_t& index, float& t) const {
+    if (times.size() < 2 || time <= times.front()) { index = 0; return false; }
+    if (time >= times.back()) { index = times.size() - 1; return false; }
+
+    size_t low = 0, high = times.size() - 1; // times[low] < time < times[high]
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        (times[middle] <= time ? low : high) = middle;
+    }
+    index = low;
+    float span = times[high] - times[low];
+    t = span > 0.0f ? (time - times[low]) / span : 1.0f;
+    return true;
+}
+
+#endif // CORE_KEYFRAME_TRACKS_H
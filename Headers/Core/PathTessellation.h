@@ -0,0 +1,27 @@
+#pragma once
+#ifndef CORE_PATH_TESSELLATION_H
+#define CORE_PATH_TESSELLATION_H
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <vector>
+
+// Error bounds for tessellateCurve; a span is split until all enabled bounds hold
+struct PathTolerance {
+    float chordal = 0.01f; // World units between the curve and the span's chord
+    float angle = 0.05f;   // Radians between the tangents at the span's ends
+
+    // Optional screen-space chordal error, replaces the world-space one when > 0
+    float pixels = 0.0f;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec2 viewport = glm::vec2(1.0f); // In pixels
+
+    int maxDepth = 10; // Halvings of an initial span
+};
+
+// Polyline through curve(u) for u in [0, 1], ends included. Starts from initialSpans uniform spans
+// (enough that no span hides a whole S-bend) and halves each one until it meets the tolerance.
+std::vector<glm::vec3> tessellateCurve(const std::function<glm::vec3(float)>& curve,
+    const std::function<glm::vec3(float)>& derivative, int initialSpans, const PathTolerance& tolerance);
+
+#endif // CORE_PATH_TESSELLATION_H
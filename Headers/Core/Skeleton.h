@@ -0,0 +1,30 @@
+#pragma once
+#ifndef CORE_SKELETON_H
+#define CORE_SKELETON_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <string>
+#include <vector>
+
+// Define a Joint structure
+struct Joint {
+    std::string name; // Name of the joint for clarity
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    std::vector<int> childrenIndices;
+};
+
+Joint createJoint(const std::string& name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+std::vector<Joint> createStickFigureSkeleton(); // Torso (index 1) is the root
+
+// Local transform of a joint relative to its parent
+glm::mat4 getJointModelMatrix(const Joint& joint);
+// World matrix of every joint, indexed like the skeleton
+void computeJointMatrices(const std::vector<Joint>& skeleton, std::vector<glm::mat4>& worldMatrices);
+
+#endif // CORE_SKELETON_H
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef CORE_SPEED_CURVE_H
+#define CORE_SPEED_CURVE_H
+
+#include <glm/glm.hpp>
+#include <vector>
+
+enum class SpeedProfile {
+    CONSTANT,    // Same speed along the whole path
+    EASE_IN_OUT, // Cubic ease in and out
+    CUSTOM       // Piecewise linear through user points
+};
+
+// Fraction of the path length covered at a fraction of the traversal time
+struct SpeedCurve {
+    SpeedProfile profile = SpeedProfile::EASE_IN_OUT;
+    // CUSTOM only: (time fraction, distance fraction) pairs; (0, 0) and (1, 1) are implied.
+    // Distance fractions should not decrease, or the camera runs backwards.
+    std::vector<glm::vec2> points;
+
+    float distanceFraction(float timeFraction) const;
+    float distanceRate(float timeFraction) const; // d(distanceFraction)/d(timeFraction)
+};
+
+#endif // CORE_SPEED_CURVE_H
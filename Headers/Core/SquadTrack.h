@@ -0,0 +1,34 @@
+#pragma once
+#ifndef CORE_SQUAD_TRACK_H
+#define CORE_SQUAD_TRACK_H
+
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <vector>
+
+enum class RotationInterpolation {
+    SLERP, // Per segment; the angular velocity jumps at every key
+    SQUAD  // Spherical spline through the keys, smooth across them
+};
+
+// Shoemake's SQUAD through a sequence of rotation keys. build() flips keys onto a common
+// hemisphere and precomputes one inner control quaternion per key; evaluating a segment
+// is then three slerps and no allocation.
+class SquadTrack {
+public:
+    void build(const std::vector<glm::quat>& rotations);
+
+    size_t size() const { return keys.size(); }
+
+    // Rotation between keys[segment] and keys[segment + 1] at blend factor t
+    glm::quat evaluate(size_t segment, float t) const;
+
+private:
+    std::vector<glm::quat> keys;
+    std::vector<glm::quat> inner; // s_i = q_i exp(-(log(q_i^-1 q_i+1) + log(q_i^-1 q_i-1)) / 4)
+};
+
+#endif // CORE_SQUAD_TRACK_H
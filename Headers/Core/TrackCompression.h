@@ -0,0 +1,61 @@
+#pragma once
+#ifndef CORE_TRACK_COMPRESSION_H
+#define CORE_TRACK_COMPRESSION_H
+
+#include "KeyFrame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Largest reconstruction error allowed per property when keys are dropped
+struct CompressionTolerance {
+    float position = 0.001f; // World units
+    float rotation = 0.001f; // Radians
+    float scale = 0.001f;
+};
+
+// Position, rotation and scale of a keyframe track, each reduced to the keys that linear
+// (slerp for rotation) interpolation cannot reconstruct within the tolerance, then quantized:
+// positions and scales to 16 bits per component relative to the track's range, rotations to
+// 48-bit smallest-three. Sampling decodes the two keys around the time on the fly.
+// Quantization adds at most half a step on top of the tolerance. FFD control points are not part
+// of the track.
+class CompressedTrack {
+public:
+    static CompressedTrack compress(const std::vector<KeyFrame>& keyFrames, const CompressionTolerance& tolerance);
+
+    bool isEmpty() const { return positions.times.empty(); }
+    size_t getKeyCount() const { return positions.times.size() + rotations.times.size() + scales.times.size(); }
+    size_t getByteSize() const;
+
+    // Clamped to the first and last key outside the track
+    glm::vec3 samplePosition(float time) const;
+    glm::quat sampleRotation(float time) const;
+    glm::vec3 sampleScale(float time) const;
+
+private:
+    struct Vec3Channel {
+        std::vector<float> times;
+        std::vector<uint16_t> values; // 3 per key
+        glm::vec3 minimum = glm::vec3(0.0f);
+        glm::vec3 extent = glm::vec3(0.0f);
+
+        glm::vec3 decode(size_t key) const;
+        glm::vec3 sample(float time) const;
+    };
+
+    struct QuatChannel {
+        std::vector<float> times;
+        std::vector<uint16_t> values; // 3 per key, smallest-three
+
+        glm::quat decode(size_t key) const;
+        glm::quat sample(float time) const;
+    };
+
+    Vec3Channel positions;
+    QuatChannel rotations;
+    Vec3Channel scales;
+};
+
+#endif // CORE_TRACK_COMPRESSION_H
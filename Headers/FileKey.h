@@ -0,0 +1,22 @@
+#pragma once
+#ifndef FILE_KEY_H
+#define FILE_KEY_H
+
+#include <filesystem>
+#include <string>
+
+// Cache key for an asset on disk: canonical path plus last write time,
+// so a file that changed on disk is reloaded instead of served stale
+inline std::string makeFileCacheKey(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path canonicalPath = std::filesystem::canonical(path, ec);
+    if (ec) {
+        return path + "|0"; // Missing file, fall back to the raw path
+    }
+
+    auto writeTime = std::filesystem::last_write_time(canonicalPath, ec);
+    long long stamp = ec ? 0 : static_cast<long long>(writeTime.time_since_epoch().count());
+    return canonicalPath.string() + "|" + std::to_string(stamp);
+}
+
+#endif // FILE_KEY_H
@@ -0,0 +1,111 @@
+#pragma once
+#ifndef FRAME_CACHE_H
+#define FRAME_CACHE_H
+
+#include "ChannelState.h"
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class Channel;
+
+struct FrameCacheKey {
+    uint64_t channelId = 0;
+    uint64_t version = 0;  // Channel::getVersion(), so edits never hit stale entries
+    int64_t timeTick = 0;  // Local time in units of the time quantum
+
+    bool operator==(const FrameCacheKey& other) const {
+        return channelId == other.channelId && version == other.version && timeTick == other.timeTick;
+    }
+};
+
+struct FrameCacheKeyHash {
+    size_t operator()(const FrameCacheKey& key) const {
+        uint64_t hash = key.channelId * 0x9E3779B97F4A7C15ull;
+        hash ^= key.version + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        hash ^= static_cast<uint64_t>(key.timeTick) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        return static_cast<size_t>(hash);
+    }
+};
+
+// LRU cache of evaluated channel states keyed by (channel, version, quantized local time).
+// Entries beyond the memory budget are dropped, or with spilling enabled written to a
+// memory-mapped ring file and copied back on a later hit, which is still far cheaper than FFD.
+// Thread-safe; channels may be evaluated from several worker threads at once.
+class FrameCache {
+public:
+    static FrameCache& getInstance();
+
+    // Cached Channel::evaluate: the channel is evaluated at the quantized time on a miss
+    ChannelState evaluate(const Channel& channel, float localTime);
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    void setTimeQuantum(float seconds); // Clears the cache
+    float getTimeQuantum() const { return timeQuantum; }
+
+    bool enableSpill(const std::string& path, size_t capacity);
+    void disableSpill();
+    bool isSpillEnabled() const;
+
+    void clear();
+
+    struct Stats {
+        size_t residentBytes;
+        size_t entryCount;
+        size_t spilledCount;
+        uint64_t hits;
+        uint64_t misses;
+    };
+    Stats getStats() const;
+
+private:
+    FrameCache() = default;
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+    struct Entry {
+        FrameCacheKey key;
+        ChannelState state;
+        size_t bytes;
+    };
+
+    struct SpillRecord {
+        FrameCacheKey key;
+        size_t offset;
+        size_t size;
+    };
+
+    static size_t measure(const ChannelState& state);
+    bool lookupLocked(const FrameCacheKey& key, ChannelState& state);
+    void insertLocked(const FrameCacheKey& key, const ChannelState& state);
+    void evictLocked();
+    void spillLocked(const Entry& entry);
+    bool unspillLocked(const FrameCacheKey& key, ChannelState& state);
+
+    mutable std::mutex mutex;
+    std::atomic<bool> enabled{ true };
+    std::atomic<float> timeQuantum{ 1.0f / 240.0f };
+    size_t memoryBudget = 256u * 1024u * 1024u;
+
+    std::list<Entry> lru; // Most recently used first
+    std::unordered_map<FrameCacheKey, std::list<Entry>::iterator, FrameCacheKeyHash> entries;
+    size_t residentBytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    MappedFile spillFile;
+    size_t spillHead = 0;
+    std::deque<SpillRecord> spillRecords; // In write order, the oldest get overwritten first
+    std::unordered_map<FrameCacheKey, size_t, FrameCacheKeyHash> spillIndex; // Key -> offset
+};
+
+#endif // FRAME_CACHE_H
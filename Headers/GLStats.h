@@ -0,0 +1,24 @@
+#pragma once
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+#include <cstdint>
+
+// Draw calls and bytes handed to the driver since the last reset
+struct GLCounters {
+    uint64_t drawCalls = 0;
+    uint64_t bufferUploadBytes = 0;  // glBufferData (with data) + glBufferSubData
+    uint64_t textureUploadBytes = 0; // glTexImage2D (with data) + glTexSubImage2D
+};
+
+// Counts GL work by wrapping glad's function pointers, so every call site is covered,
+// including the learnopengl headers, without touching them.
+// Call install() once after gladLoadGLLoader; counting is for the GL context thread only.
+namespace GLStats {
+    void install();
+    bool isInstalled();
+    void reset();
+    GLCounters get();
+}
+
+#endif // GL_STATS_H
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+// OpenGL 3.3 core context without a window, for batch rendering.
+// Linux: EGL on the surfaceless platform (Mesa llvmpipe works on machines without display or GPU).
+// Windows: a hidden GLFW window, as there is no portable surfaceless path there.
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Creates the context, makes it current and loads the GL functions; throws std::runtime_error on failure
+    void create();
+    void destroy();
+
+private:
+    void* display = nullptr; // EGLDisplay
+    void* context = nullptr; // EGLContext, or the hidden GLFWwindow on Windows
+};
+
+#endif // HEADLESS_CONTEXT_H
@@ -11,6 +11,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 
 
 // Forward declare the Channel class to avoid circular dependency
@@ -20,6 +21,9 @@ void setupImGui(GLFWwindow* window, Animation* aMAIN);
 void renderImGui();
 void cleanupImGui();
 
+// Held while the editors run, when the scene is updated on a simulation thread (nullptr = no locking)
+void setSceneMutex(std::mutex* mutex);
+
 void renderKeyFrameEditor(); // New function to render the key-frame editor
 
 extern std::shared_ptr<Channel> selectedChannel; // Declare selectedChannel as extern
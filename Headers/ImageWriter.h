@@ -0,0 +1,18 @@
+#pragma once
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <cstdint>
+#include <string>
+
+enum class ImageFormat {
+    PNG, // 8-bit RGBA, stored (uncompressed) deflate: fast to write, larger files
+    PPM, // Binary P6 RGB
+    RAW  // Tightly packed RGBA rows, top row first
+};
+
+// Writes tightly packed RGBA8 pixels given bottom row first, as glReadPixels returns them.
+// Returns false and reports on std::cerr if the file cannot be written.
+bool writeImage(const std::string& path, ImageFormat format, const uint8_t* rgba, int width, int height);
+
+#endif // IMAGE_WRITER_H
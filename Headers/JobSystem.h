@@ -0,0 +1,55 @@
+#pragma once
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool for CPU-only work (channel updates).
+// Every worker owns a deque: it pops its own jobs from the back and steals
+// from the front of the others. Threads that are not workers share queue 0.
+// Jobs must never issue GL calls; the GL context lives on the render thread.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    static JobSystem& getInstance();
+
+    explicit JobSystem(unsigned workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(Job job);
+
+    // Run jobs on the calling thread until done() returns true
+    void runUntil(const std::function<bool()>& done);
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool tryGetJob(size_t queueIndex, Job& job);
+    void workerLoop(size_t queueIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<int> queuedJobs{ 0 };
+    std::atomic<bool> stopping{ false };
+};
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere), either read-only
+// or as a writable file of fixed size that is created or truncated on open
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool openReadOnly(const std::string& path);
+    bool createReadWrite(const std::string& path, size_t size);
+    void close();
+
+    bool isOpen() const { return mapped != nullptr; }
+    const unsigned char* data() const { return mapped; }
+    unsigned char* writableData() { return writable ? mapped : nullptr; }
+    size_t size() const { return length; }
+
+private:
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+    unsigned char* mapped = nullptr;
+    size_t length = 0;
+    bool writable = false;
+};
+
+#endif // MAPPED_FILE_H
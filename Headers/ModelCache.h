@@ -0,0 +1,112 @@
+#pragma once
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+// for object loading I use the learnopengl implementation, all credits go to the authors
+#include <learnopengl/model.h>
+
+#include "TextureCache.h"
+#include "ChannelState.h"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Immutable rest-pose geometry of one mesh, shared by every channel using the asset
+struct SharedMesh {
+    GLuint vbo = 0;                         // Interleaved Vertex buffer in learnopengl layout
+    GLuint ebo = 0;
+    GLsizei indexCount = 0;
+    std::vector<glm::vec3> restPositions;   // CPU copy of the rest positions, input to deformation
+    std::vector<Texture> textures;
+};
+
+// A model loaded once from disk; only ever handed out as shared_ptr<const ModelAsset>.
+// The first import goes through Assimp and writes a cooked "<path>.meshcache" file;
+// later imports map that file and upload it directly while the source hash matches
+// and its material libraries and textures are unchanged on disk.
+class ModelAsset {
+public:
+    explicit ModelAsset(const std::string& path);
+    ~ModelAsset();
+
+    ModelAsset(const ModelAsset&) = delete;
+    ModelAsset& operator=(const ModelAsset&) = delete;
+
+    const std::vector<SharedMesh>& getMeshes() const { return meshes; }
+    size_t getVertexCount() const;
+    bool isLoaded() const { return !meshes.empty(); }
+
+private:
+    bool loadCooked(const std::string& cookedPath, uint64_t sourceHash, const std::string& directory);
+    void loadWithAssimp(const std::string& path, const std::string& cookedPath, uint64_t sourceHash,
+        const std::string& directory, const std::vector<std::string>& materialFiles);
+    void resolveTextures(std::vector<Texture>& textures, const std::string& directory);
+
+    std::vector<SharedMesh> meshes;
+    std::vector<GLuint> vertexArrays; // VAOs created by the Assimp loader, unused for drawing
+    std::vector<std::shared_ptr<CachedTexture>> cachedTextures; // Textures of either load path
+};
+
+// Per-channel view of a shared ModelAsset. The asset's buffers are never written;
+// a channel that deforms the mesh gets its own position buffer layered on top.
+// Render thread only.
+class ModelInstance {
+public:
+    explicit ModelInstance(std::shared_ptr<const ModelAsset> asset);
+    ~ModelInstance();
+
+    ModelInstance(const ModelInstance&) = delete;
+    ModelInstance& operator=(const ModelInstance&) = delete;
+
+    const ModelAsset& getAsset() const { return *asset; }
+    const std::shared_ptr<const ModelAsset>& getSharedAsset() const { return asset; }
+
+    // Positions to draw instead of the rest pose (nullptr = rest pose).
+    // Uploaded by the next Draw, and only if they differ from the last ones drawn.
+    void setDeformedPositions(std::shared_ptr<const DeformedPositions> positions);
+
+    void Draw(Shader& shader);
+
+private:
+    struct MeshBinding {
+        GLuint vao = 0;
+        GLuint positionVBO = 0;
+        bool positionsFromDeformation = false;
+    };
+
+    void setupBindings();
+    void bindPositionAttribute(size_t meshIndex, bool deformed);
+
+    std::shared_ptr<const ModelAsset> asset;
+    std::vector<MeshBinding> bindings;
+    std::shared_ptr<const DeformedPositions> deformedPositions;
+    bool deformationDirty = false;
+};
+
+// Shares ModelAssets between channels, keyed by canonical path + modification time.
+// An asset is freed when the last ModelInstance using it is destroyed.
+// All methods must be called on the thread that owns the GL context.
+class ModelCache {
+public:
+    static ModelCache& getInstance();
+
+    std::shared_ptr<const ModelAsset> load(const std::string& path);
+
+    size_t getAssetCount() const { return entries.size(); }
+
+private:
+    ModelCache() = default;
+    ModelCache(const ModelCache&) = delete;
+    ModelCache& operator=(const ModelCache&) = delete;
+
+    void release(const std::string& key, ModelAsset* asset);
+
+    std::unordered_map<std::string, std::weak_ptr<const ModelAsset>> entries;
+};
+
+#endif // MODEL_CACHE_H
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef OFFLINE_RENDERER_H
+#define OFFLINE_RENDERER_H
+
+#include "ImageWriter.h"
+
+#include <glad/glad.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct OfflineRenderSettings {
+    int width = 1920;
+    int height = 1080;
+    ImageFormat format = ImageFormat::PNG;
+    std::string outputPattern = "frame_%05d.png"; // printf pattern, gets the frame number
+    int readbackDepth = 3;       // Frames in flight between glReadPixels and mapping the PBO
+    size_t maxQueuedFrames = 8;  // Frames waiting for the writers before rendering stalls
+    int writerThreads = 2;
+};
+
+// Renders frames into an offscreen FBO and writes them to disk without stalling the GPU:
+// each frame is read back into a ring of pixel buffer objects and only mapped a few frames
+// later, then encoded and written by background threads.
+// All methods except the writer threads run on the thread that owns the GL context.
+class OfflineRenderer {
+public:
+    explicit OfflineRenderer(const OfflineRenderSettings& settings);
+    ~OfflineRenderer();
+
+    OfflineRenderer(const OfflineRenderer&) = delete;
+    OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+    bool init();
+
+    // True if the pattern has exactly one %d or %0Nd and no other conversion than %%
+    static bool isValidPattern(const std::string& pattern);
+
+    void beginFrame(); // Binds and clears the FBO; draw the frame after this
+    void endFrame();   // Starts the asynchronous readback of the frame just drawn
+    void finish();     // Reads back the frames still in flight and waits for the writers
+
+    int getFramesWritten() const { return framesWritten.load(); }
+    int getFramesFailed() const { return framesFailed.load(); }
+
+private:
+    struct Readback {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        int frameIndex = -1;
+    };
+
+    struct EncodedFrame {
+        int frameIndex;
+        std::vector<uint8_t> pixels;
+    };
+
+    void collect(Readback& readback);
+    void writerLoop();
+    std::string framePath(int frameIndex) const;
+
+    OfflineRenderSettings settings;
+    size_t frameBytes = 0;
+
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    GLuint depthBuffer = 0;
+    std::vector<Readback> readbacks;
+    int nextFrame = 0;
+
+    std::vector<std::thread> writers;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    std::deque<EncodedFrame> queue;
+    bool stopping = false;
+
+    std::atomic<int> framesWritten{ 0 };
+    std::atomic<int> framesFailed{ 0 };
+};
+
+#endif // OFFLINE_RENDERER_H
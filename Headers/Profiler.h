@@ -0,0 +1,90 @@
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <glad/glad.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timing of one channel within one frame
+struct ChannelTiming {
+    std::string name;
+    double updateStartUs = 0.0; // CPU update span, microseconds since the profiler started
+    double updateUs = 0.0;
+    int updateThread = 0;
+    double renderStartUs = 0.0; // CPU time when the draw calls were issued
+    double renderCpuUs = 0.0;
+    double gpuUs = -1.0;        // GL_TIME_ELAPSED, -1 until the query result came back
+};
+
+struct ProfiledFrame {
+    uint64_t frameIndex = 0;
+    double startUs = 0.0;
+    double frameUs = 0.0;
+    std::vector<ChannelTiming> channels;
+};
+
+// Records per-channel update (CPU) and render (CPU + GPU) times into a ring of recent frames.
+// GPU times come from GL_TIME_ELAPSED queries in two alternating sets: a frame's queries are
+// read when the set is reused two frames later, by which time the GPU has finished them.
+// Update timings may be recorded from any thread; frames and GPU queries belong to the render thread.
+class Profiler {
+public:
+    static Profiler& getInstance();
+
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void beginFrame();
+    void endFrame();
+
+    double nowUs() const;
+    void recordUpdate(const std::string& channelName, double startUs, double endUs);
+    void beginRender(const std::string& channelName);
+    void endRender();
+
+    // Copy of the recorded frames, oldest first
+    std::vector<ProfiledFrame> getFrames() const;
+    bool exportChromeTrace(const std::string& path) const;
+
+    static const size_t frameCapacity = 300;
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ChannelTiming& channelLocked(ProfiledFrame& frame, const std::string& name);
+    void resolveQueries(int set);
+    static int threadSlot();
+
+    struct PendingQuery {
+        GLuint query;
+        uint64_t frameIndex;
+        std::string channelName;
+    };
+
+    std::atomic<bool> enabled{ false }; // Set by the GUI, read by the simulation thread
+    std::chrono::steady_clock::time_point origin;
+
+    mutable std::mutex mutex;
+    std::vector<ProfiledFrame> ring; // frameCapacity slots
+    size_t ringHead = 0;             // Slot of the frame in progress
+    size_t ringCount = 0;
+    uint64_t frameCounter = 0;
+    bool frameOpen = false;
+
+    // Render thread only
+    std::vector<GLuint> queryPool[2];
+    std::vector<PendingQuery> pending[2];
+    int querySet = 0;
+    bool queryActive = false;
+    std::string renderChannel;
+    double renderStartUs = 0.0;
+};
+
+#endif // PROFILER_H
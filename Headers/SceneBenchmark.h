@@ -0,0 +1,15 @@
+#pragma once
+#ifndef SCENE_BENCHMARK_H
+#define SCENE_BENCHMARK_H
+
+// Renders procedurally generated scenes offscreen and reports frame rate, p50/p99 frame time,
+// draw calls, upload bytes and peak RSS. The scene and its assets depend only on the options
+// and the seed, so two builds can be compared on the same numbers.
+//   --scene-bench [--channels <n>] [--backgrounds <n>] [--cameras <n>] [--ffd <n>] [--characters <n>]
+//                 [--keyframes <k>] [--vertices <v>] [--control-points <c>] [--frames <m>] [--warmup <w>]
+//                 [--size <w>x<h>] [--seed <s>] [--assets <dir>] [--bench-out <file.json>]
+// Runs on the headless context, so on a machine without a GPU Mesa's llvmpipe does the rendering
+// (LIBGL_ALWAYS_SOFTWARE=1 forces it where a GPU is present).
+int runSceneBenchmark(int argc, char** argv);
+
+#endif // SCENE_BENCHMARK_H
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include "Animation.h"
+#include <memory>
+#include <string>
+
+// Text scene format: every channel with its type, settings, keyframes and dependencies.
+//
+//   Scene: <animation name>
+//   StepRate: 60                (fixed simulation steps per second)
+//   Channel: <ChannelType as int> <channel name>
+//   Active: 1
+//   FrameRate: 24
+//   TimeOffset: 0               (placement on the timeline, see Channel::toLocalTime)
+//   TimeScale: 1
+//   Set <Key>: <value>          (channel specific, see Channel::writeSceneSettings)
+//   KeyFrame 0 ...              (same lines as Channel::loadKeyFramesFromFile)
+//   EndChannel
+//   Dependency: <channel name> -> <dependency name>
+//   LookAt: <camera channel name> -> <target channel name>
+//
+// Loading creates GL resources, so it needs a current GL context.
+bool saveScene(const Animation& animation, const std::string& path);
+bool loadScene(Animation& animation, const std::string& path);
+
+std::shared_ptr<Channel> createChannel(ChannelType type, const std::string& name);
+
+#endif // SCENE_FILE_H
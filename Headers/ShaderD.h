@@ -10,6 +10,10 @@ class ShaderD {
 public:
     GLuint ID;
     ShaderD(const char* vertexPath, const char* fragmentPath);
+    ~ShaderD(); // Deletes the program, on the thread that owns the GL context
+
+    ShaderD(const ShaderD&) = delete;
+    ShaderD& operator=(const ShaderD&) = delete;
     void use();
     bool isCompiled() const;
 
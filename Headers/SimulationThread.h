@@ -0,0 +1,56 @@
+#pragma once
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include "Animation.h"
+#include "ChannelState.h"
+#include "TripleBuffer.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs Animation::update at the animation's fixed step rate on its own thread and publishes a FrameSnapshot
+// after every step. The render thread draws the newest snapshot without waiting for the update.
+// Scene edits reach it as commits published to the animation (see Animation::publish), applied
+// between two steps; anything else that mutates the scene from another thread (the GUI's
+// transport controls) must hold getSceneMutex().
+class SimulationThread {
+public:
+    explicit SimulationThread(Animation& animation);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(); }
+
+    // Render thread only: the newest published snapshot (empty before the first step)
+    const FrameSnapshot& latestSnapshot();
+
+    // Render thread only: drops channels that left the scene while a frame was in flight,
+    // so their GL objects are deleted on the thread that owns the context
+    void releaseRetiredChannels();
+
+    std::mutex& getSceneMutex() { return sceneMutex; }
+
+private:
+    void run();
+
+    Animation& animation;
+
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::mutex sceneMutex;
+
+    TripleBuffer<FrameSnapshot> snapshots;
+
+    std::mutex retiredMutex;
+    std::vector<std::shared_ptr<Channel>> retiredChannels;
+};
+
+#endif // SIMULATION_THREAD_H
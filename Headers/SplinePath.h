@@ -0,0 +1,32 @@
+#pragma once
+#ifndef SPLINE_PATH_H
+#define SPLINE_PATH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// A Bezier path drawn from its control points alone: they live in a buffer texture and the
+// vertex shader (path_spline.vs) evaluates the curve from gl_VertexID, so nothing is tessellated
+// on the CPU and editing the path re-uploads a few floats. Render thread only.
+class SplinePath {
+public:
+    SplinePath();
+    ~SplinePath();
+
+    SplinePath(const SplinePath&) = delete;
+    SplinePath& operator=(const SplinePath&) = delete;
+
+    void setControlPoints(const std::vector<glm::vec3>& points);
+    int getControlPointCount() const { return controlPointCount; }
+
+    // One line strip of sampleCount vertices
+    void draw(const glm::mat4& view, const glm::mat4& projection, int sampleCount) const;
+
+private:
+    GLuint buffer = 0;
+    GLuint texture = 0;
+    int controlPointCount = 0;
+};
+
+#endif // SPLINE_PATH_H
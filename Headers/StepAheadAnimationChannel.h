@@ -1,33 +1,69 @@
 #ifndef STEPAHEADANIMATIONCHANNEL_H
 #define STEPAHEADANIMATIONCHANNEL_H
 
-// for object loading I use the learnopengl implementation, all credits go to the authors
-#include <learnopengl/model.h>
-
 #include "Channel.h"
+#include "ModelCache.h"
+#include "Core/SquadTrack.h"
+#include "Core/TrackCompression.h"
 #include <iostream> // Debugging
 
 #include <glm/gtx/string_cast.hpp>
+#include <memory>
 
 class StepAheadAnimationChannel : public Channel {
 public:
     StepAheadAnimationChannel(const std::string& name);
 
     void update(float deltaTime) override;
+    void seek(float localTime) override;
     void render(const glm::mat4& view, const glm::mat4& projection);
+    ChannelState captureState() const override;
+    ChannelState evaluate(float time) const override;
+    void renderState(const ChannelState& state, const glm::mat4& view, const glm::mat4& projection) override;
+    std::shared_ptr<Channel> clone() const override;
 
     void importObject(const std::string& path);
     void setupShader(const std::string& vertexPath, const std::string& fragmentPath);
 
-private:
-    Model* model = nullptr;
-    Shader* shader = nullptr;
-    std::vector<FFDControlPoint> currentControlPoints;
+    void setRotationInterpolation(RotationInterpolation interpolation);
+    RotationInterpolation getRotationInterpolation() const { return rotationInterpolation; }
+
+    // Plays the transform from an error-bounded, quantized copy of the keys (slerp rotation);
+    // the keyframes stay the editable source and the copy is rebuilt whenever they change
+    void setCompressedPlayback(bool enabled, const CompressionTolerance& tolerance = CompressionTolerance());
+    bool isCompressedPlayback() const { return compressedPlayback; }
+    const CompressionTolerance& getCompressionTolerance() const { return compressionTolerance; }
+    const CompressedTrack& getCompressedTrack() const { return compressedTrack; }
+
+    void writeSceneSettings(std::ostream& out) const override;
+    void readSceneSetting(const std::string& key, const std::string& value) override;
+
+protected:
+    void onChanged() override;
 
-    void interpolateControlPoints();
+private:
+    std::unique_ptr<ModelInstance> model; // Shared rest-pose asset + this channel's GPU position buffer
+    std::shared_ptr<Shader> shader; // Shared with clones, replaced (never modified) by setupShader
+    std::string objectPath;       // Kept for scene files
+    std::string vertexShaderPath;
+    std::string fragmentShaderPath;
     float currentTime = 0.0f;
 
-    void applyFFD();
+    RotationInterpolation rotationInterpolation = RotationInterpolation::SQUAD;
+    SquadTrack rotationTrack; // Rebuilt from the keyframes whenever they change
+    bool compressedPlayback = false;
+    CompressionTolerance compressionTolerance;
+    CompressedTrack compressedTrack; // Only built while compressedPlayback is on
+
+    // Pure evaluation helpers shared by update() and evaluate(); they sample the base class's
+    // tracks, the kernels live in Core/
+    void evaluateTransform(float time, glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const;
+    std::vector<FFDControlPoint> evaluateControlPoints(float time) const;
+    void applyFFD(const std::vector<FFDControlPoint>& controlPoints, DeformedPositions& deformed) const;
+
+    // CPU-side deformation (nullptr = rest pose). Never modified once evaluated, so it can be
+    // shared with captured snapshots and the FrameCache.
+    std::shared_ptr<const DeformedPositions> deformedPositions;
 
     glm::vec3 interpolatedPosition;
     glm::quat interpolatedRotation;
@@ -35,12 +71,7 @@ private:
     glm::vec3 lightPosition;
     glm::vec3 viewPosition;
 
-    std::vector<Vertex> originalPositions;
-    bool stored = false;
-    void storeOriginalPositions();
-
-    void interpolateKeyFrame();
-    glm::mat4 getModelMatrix() const;
+    static glm::mat4 getModelMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
 };
 
 #endif // STEPAHEADANIMATIONCHANNEL_H
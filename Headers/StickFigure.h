@@ -19,38 +19,36 @@
 
 #include <functional>
 
+#include "Core/Skeleton.h"
+
 #ifndef M_PI
     #define M_PI 3.14159265358979323846
 #endif
 
-// Define a Joint structure
-struct Joint {
-    std::string name; // Name of the joint for clarity
-    glm::vec3 position;
-    glm::quat rotation;
-    glm::vec3 scale;
-    std::vector<int> childrenIndices;
-};
-
 class StickFigure {
 public:
     StickFigure();
+    ~StickFigure(); // Frees the GL objects, on the thread that owns the context
+
+    StickFigure(const StickFigure&) = delete;
+    StickFigure& operator=(const StickFigure&) = delete;
+
     void render(const glm::mat4& view, const glm::mat4& projection);
-    glm::mat4 getJointModelMatrix(const Joint& joint);
     
 private:
-    GLuint cylinderVAO, cylinderVBO, sphereVAO, sphereVBO;
+    GLuint cylinderVAO = 0, cylinderVBO = 0, cylinderEBO = 0;
+    GLuint sphereVAO = 0, sphereVBO = 0, sphereEBO = 0;
     GLuint cylinderIndexCount, sphereIndexCount;
     Shader* shader = nullptr;
     void setupSphere();
     void setupCylinder();
 
     std::vector<Joint> skeleton;
+    std::vector<glm::mat4> jointMatrices; // Reused by render()
     
     void drawCylinder(const glm::mat4& modelMatrix, const glm::mat4& view, const glm::mat4& projection);
     void drawSphere(const glm::mat4& modelMatrix, const glm::mat4& view, const glm::mat4& projection);
 
-    Joint createJoint(const std::string& name, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
     int getParentIndex(int jointIndex) const;
 };
 
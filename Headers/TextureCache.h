@@ -0,0 +1,44 @@
+#pragma once
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <glad/glad.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A GL texture shared by every channel that loaded the same image(s).
+// The texture object is deleted when the last shared_ptr to it is released.
+struct CachedTexture {
+    GLuint id = 0;
+    GLenum target = GL_TEXTURE_2D;
+    size_t byteSize = 0; // Approximate VRAM footprint (base level + mipmaps)
+};
+
+// Reference-counted texture cache keyed by canonical path + modification time.
+// All methods must be called on the thread that owns the GL context.
+class TextureCache {
+public:
+    static TextureCache& getInstance();
+
+    std::shared_ptr<CachedTexture> loadTexture2D(const std::string& path);
+    std::shared_ptr<CachedTexture> loadCubemap(const std::vector<std::string>& faces);
+
+    size_t getTextureCount() const { return entries.size(); }
+    size_t getResidentBytes() const { return residentBytes; }
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    std::shared_ptr<CachedTexture> find(const std::string& key) const;
+    std::shared_ptr<CachedTexture> insert(const std::string& key, CachedTexture* texture);
+    void release(const std::string& key, CachedTexture* texture);
+
+    std::unordered_map<std::string, std::weak_ptr<CachedTexture>> entries;
+    size_t residentBytes = 0;
+};
+
+#endif // TEXTURE_CACHE_H
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped trace zones for long captures, written to Chrome trace / Perfetto JSON.
+// Build with ANIMATION_TRACING=0 to compile every TRACE_* macro away.
+#ifndef ANIMATION_TRACING
+#define ANIMATION_TRACING 1
+#endif
+
+namespace Trace {
+    // Zones are only recorded while capturing; the check is one relaxed load
+    void setCapturing(bool capturing);
+    bool isCapturing();
+
+    // Names this thread in the dumped trace; the pointer must stay valid (string literal)
+    void setThreadName(const char* name);
+
+    // Writes the events still held in every thread's ring, oldest first
+    bool dump(const std::string& path);
+
+    uint64_t nowNs();
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    extern std::atomic<bool> capturing;
+
+    class Scope {
+    public:
+        explicit Scope(const char* name) : name(capturing.load(std::memory_order_relaxed) ? name : nullptr) {
+            if (this->name) startNs = nowNs();
+        }
+        ~Scope() {
+            if (name) record(name, startNs, nowNs());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        uint64_t startNs = 0;
+    };
+}
+
+#if ANIMATION_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_FUNCTION() TRACE_SCOPE(__FUNCTION__)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_FUNCTION() ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRACE_H
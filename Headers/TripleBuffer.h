@@ -0,0 +1,44 @@
+#pragma once
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer for one producer and one consumer thread.
+// The producer fills writeBuffer() and publishes it; the consumer always picks up
+// the newest published buffer and never waits for, or blocks, the producer.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& writeBuffer() { return buffers[backIndex]; }
+
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | freshBit));
+        backIndex = previous & indexMask;
+    }
+
+    // Consumer side: returns true if a newer buffer became the read buffer
+    bool acquireLatest() {
+        if (!(middle.load() & freshBit)) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(frontIndex);
+        frontIndex = previous & indexMask;
+        return true;
+    }
+
+    const T& readBuffer() const { return buffers[frontIndex]; }
+
+private:
+    static constexpr uint8_t indexMask = 0x3;
+    static constexpr uint8_t freshBit = 0x4;
+
+    T buffers[3];
+    uint8_t backIndex = 0;           // Owned by the producer
+    uint8_t frontIndex = 1;          // Owned by the consumer
+    std::atomic<uint8_t> middle{ 2 }; // Shared slot, plus a flag for unread data
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -1,55 +1,127 @@
 #ifndef VIRTUALCAMERACHANNEL_H
 #define VIRTUALCAMERACHANNEL_H
 
-#include <glad/glad.h>
 #include "Channel.h"
-#include "ShaderD.h"
+#include "Core/CameraPath.h"
 #include <iostream>
-#include <glm/gtc/type_ptr.hpp>
-#include "Camera.h"
-#include <thread>
-#include <chrono>
+
+class ShaderD;
+class SplinePath;
+
+// What the camera looks at while it follows its path
+enum class CameraAim {
+    LOOK_AT_POINT,  // A fixed point in the world (the origin unless set)
+    KEYFRAMED,      // The keyframes' orientations, looking down their -Z axis
+    LOOK_AT_CHANNEL // The position of another channel's transform
+};
+
+// How the camera path is drawn
+enum class PathDisplay {
+    SPLINE_ON_GPU,   // Control points only, the curve is evaluated in the vertex shader
+    TESSELLATED      // Adaptive CPU polyline, see PathTolerance
+};
 
 class VirtualCameraChannel : public Channel {
 public:
     VirtualCameraChannel(const std::string& name);
+    ~VirtualCameraChannel(); // Frees the GL objects, on the thread that owns the context
     void update(float deltaTime) override;
+    void seek(float localTime) override;
     void render(const glm::mat4& view, const glm::mat4& projection) override;
+    ChannelState captureState() const override;
+    ChannelState evaluate(float time) const override;
+    std::shared_ptr<Channel> clone() const override;
     void printKeyframesWithInterpolations(std::vector<KeyFrame> interpolatedKeyFrames);
     std::vector<KeyFrame> interpolateKeyFrames() const;
     void startTraversal(); // Method to start traversal
     bool isTraversalInProgress = false;
 
-private:
-    glm::vec3 interpolatePosition(float time) const;
-    glm::quat interpolateOrientation(float time) const;
-    glm::vec3 interpolateScale(float time) const;
+    // How the camera's speed varies along the path (applied to arc length, not the curve parameter)
+    void setSpeedCurve(const SpeedCurve& curve);
+    const SpeedCurve& getSpeedCurve() const { return path.getSpeedCurve(); }
+    const CameraPath& getPath() const { return path; }
+
+    // Speed over time, recomputed from the speed curve's derivative whenever the path changes
+    const std::vector<glm::vec2>& getSpeedProfile() const { return speedProfile; }
+    void setSpeedCurveInScene(bool show) { speedCurveInScene = show; }
+    bool isSpeedCurveInScene() const { return speedCurveInScene; }
+
+    void setPathDisplay(PathDisplay display);
+    PathDisplay getPathDisplay() const { return pathDisplay; }
+    void setSplineSampleCount(int count) { splineSampleCount = count; }
+    int getSplineSampleCount() const { return splineSampleCount; }
 
+    // How finely the tessellated path is drawn; a pixel tolerance re-tessellates for every frame's view
+    void setPathTolerance(const PathTolerance& tolerance);
+    const PathTolerance& getPathTolerance() const { return pathTolerance; }
+    int getPathVertexCount() const { return pathVertexCount; }
+
+    void setAim(CameraAim aim);
+    CameraAim getAim() const { return aim; }
+    void setLookAtPoint(const glm::vec3& point);
+    const glm::vec3& getLookAtPoint() const { return lookAtPoint; }
+    // The camera updates after the target (it becomes a dependency), so live playback aims
+    // at the target's pose of the same step. The target is kept by handle and re-resolved
+    // whenever the owning animation's channels change. Call on the camera returned by
+    // animation.editChannel; returns false and keeps the previous target if it would close a cycle
+    bool setLookAtChannel(Animation& animation, ChannelHandle target);
+    std::shared_ptr<Channel> getLookAtChannel() const { return lookAtChannel.lock(); }
+    ChannelHandle getLookAtHandle() const { return lookAtHandle; }
+    bool refersTo(ChannelHandle handle) const override { return handle == lookAtHandle; }
+    void resolveReferences(const Animation& animation) override;
+
+    void writeSceneSettings(std::ostream& out) const override;
+    void readSceneSetting(const std::string& key, const std::string& value) override;
+
+protected:
+    void onChanged() override;
+
+private:
     void initPathRendering(); // Initialization function
 
     float currentTime = 0.0f;
     bool traversalComplete = false; // Flag to indicate traversal is complete
      // Flag to check if traversal is in progress
 
-    std::vector<KeyFrame> interpolatedKeyFrames; // Store interpolated keyframes for traversal
-    void traversePath(); // Simplified traversePath method
+    CameraPath path; // Rebuilt whenever the keyframes change
+    std::vector<glm::vec2> speedProfile; // (time, speed), rebuilt with the path
+    bool speedCurveInScene = true; // Draw the profile as lines in the world, next to the path
+    bool traversalStarted = false; // The camera follows the playhead once startTraversal() was called
+    CameraPath::Cursor cursor;     // Playback position on the path, advanced by seek()
 
-    GLuint pathVAO, pathVBO;
-    GLuint keyframeVAO, keyframeVBO;
-    GLuint speedCurveVAO, speedCurveVBO;
-    bool isInitialized = false;
-    ShaderD *pathShader, *keyframeShader, *speedCurveShader;
+    CameraAim aim = CameraAim::LOOK_AT_POINT;
+    glm::vec3 lookAtPoint = glm::vec3(0.0f);
+    ChannelHandle lookAtHandle = INVALID_CHANNEL_HANDLE;
+    std::weak_ptr<Channel> lookAtChannel; // What lookAtHandle resolved to
 
-    glm::vec3 bezierInterpolate(const std::vector<glm::vec3>& points, float t) const;
-    glm::quat bezierInterpolate(const std::vector<glm::quat>& points, float t) const;
+    // Camera pose at time; the target is read live (captureState) or evaluated (offline)
+    ChannelState evaluatePose(float time, CameraPath::Cursor& cursor, bool liveTarget) const;
 
-    static float easeInOutCubic(float t);
+    // Camera pose produced by the traversal; applied to the Camera by the render thread
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    unsigned int pathVAO, pathVBO; // GL objects, render thread only
+    unsigned int keyframeVAO, keyframeVBO;
+    unsigned int speedCurveVAO, speedCurveVBO;
+    PathDisplay pathDisplay = PathDisplay::SPLINE_ON_GPU;
+    std::unique_ptr<SplinePath> splinePath;
+    int splineSampleCount = 512;
+    PathTolerance pathTolerance;
+    uint64_t uploadedPathVersion = ~0ull; // Channel version the path and keyframe buffers were built from
+    int pathVertexCount = 0;
+    int keyframeVertexCount = 0;
+    uint64_t uploadedSpeedCurveVersion = 0; // Channel version the speed curve buffer was built from
+    int speedCurveVertexCount = 0;
+    bool isInitialized = false;
+    std::shared_ptr<ShaderD> pathShader, keyframeShader, speedCurveShader; // Shared with clones
 
-    void drawPath(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& pathPositions);
-    void drawKeyframes(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& keyframePositions);
-    void drawSpeedCurve(const glm::mat4& view, const glm::mat4& projection, const std::vector<glm::vec3>& speedCurvePositions);
-    bool speedCurveDrawn = false;
-    
+    void uploadPath(const std::vector<glm::vec3>& pathPositions);
+    void uploadKeyframes();
+    void drawPath(const glm::mat4& view, const glm::mat4& projection);
+    void drawKeyframes(const glm::mat4& view, const glm::mat4& projection);
+    void drawSpeedCurve(const glm::mat4& view, const glm::mat4& projection);
+    void uploadSpeedCurve();
 };
 
 #endif // VIRTUALCAMERACHANNEL_H
@@ -0,0 +1,28 @@
+#version 330 core
+// Bezier curve through every control point, evaluated per vertex: vertex i of a line strip
+// of sampleCount vertices sits at curve parameter i / (sampleCount - 1)
+uniform samplerBuffer controlPoints; // xyz per texel
+uniform int controlPointCount;
+uniform int sampleCount;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    float u = float(gl_VertexID) / float(max(sampleCount - 1, 1));
+    int n = controlPointCount - 1;
+
+    // Horner-like evaluation of the Bernstein form, linear in the number of control points
+    float s = 1.0 - u;
+    float binomial = 1.0;
+    float uPower = 1.0;
+    vec3 point = texelFetch(controlPoints, 0).xyz * s;
+    for (int i = 1; i < n; ++i) {
+        uPower *= u;
+        binomial *= float(n - i + 1) / float(i);
+        point = (point + uPower * binomial * texelFetch(controlPoints, i).xyz) * s;
+    }
+    point += uPower * u * texelFetch(controlPoints, n).xyz;
+
+    gl_Position = projection * view * vec4(point, 1.0);
+}